@@ -0,0 +1,627 @@
+/**
+ * @file bench.c
+ * @author Marek Sedláček
+ * @date October 2026
+ *
+ * @brief Benchmark of all entry points of pso module
+ *
+ * Every entry point is run on standard functions (Sphere, Rastrigin,
+ * Rosenbrock, Ackley and Griewank) for each combination of dimensions,
+ * particle amounts and thread amounts it supports. Every run has the
+ * same budget of function evaluations, so the best found values can be
+ * compared between entry points. Each measurement is repeated and the
+ * median time is reported.
+ *
+ * Usage: bench.out [-f text|csv|json] [-r repetitions] [-b budget]
+ *                  [-d dimensions] [-p particles] [-t threads]
+ *                  [-e entry] [-F function]
+ * Lists are comma separated (e.g. `-d 3,11`), entry and function select
+ * those whose name contains given text. Single threaded entries are always
+ * run with 1 thread.
+ */
+#define _POSIX_C_SOURCE 200809L  //< Needed for clock_gettime and getopt
+#include "pso.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifndef M_PI
+// PI (Taken from boost library)
+// https://www.boost.org/doc/libs/1_56_0/boost/math/constants/constants.hpp
+#define M_PI (double)(3.14159265358979323846264338327950288419716939937510582097494459230781640628620899862803482534211706798214808651e+00)
+#endif
+
+#ifndef M_E
+// Euler's constant (taken from boost library)
+// https://www.boost.org/doc/libs/1_56_0/boost/math/constants/constants.hpp
+#define M_E (double)(2.71828182845904523536028747135266249775724709369995957496696762772407663035354759457138217852516642742746639193e+00)
+#endif
+
+#define MAX_LIST 16       //< Maximal amount of values in list option
+#define MAX_REPS 101      //< Maximal amount of repetitions
+#define MAX_COORDS 64     //< Maximal amount of coordinates of benchmarked functions
+
+static unsigned short coords = 2;  //< Amount of coordinates of benchmarked functions (funcndim has no such parameter)
+static funcndim active = NULL;     //< Benchmarked function (used by adapters)
+
+/**
+ * Sphere function (minimum 0 at origin)
+ * @param pos Array of coordinates
+ */
+static double sphere(double *pos){
+    double sum = 0.0;
+    for(unsigned short c = 0; c < coords; c++){
+        sum += pos[c] * pos[c];
+    }
+    return sum;
+}
+
+/**
+ * Rastrigin function (minimum 0 at origin, many local minima)
+ * @param pos Array of coordinates
+ */
+static double rastrigin(double *pos){
+    double sum = 10.0 * coords;
+    for(unsigned short c = 0; c < coords; c++){
+        sum += pos[c] * pos[c] - 10.0 * cos(2 * M_PI * pos[c]);
+    }
+    return sum;
+}
+
+/**
+ * Rosenbrock function (minimum 0 at (1, ..., 1), narrow curved valley)
+ * @param pos Array of coordinates
+ */
+static double rosenbrock(double *pos){
+    double sum = 0.0;
+    for(unsigned short c = 0; c + 1 < coords; c++){
+        double a = pos[c + 1] - pos[c] * pos[c];
+        double b = 1.0 - pos[c];
+        sum += 100.0 * a * a + b * b;
+    }
+    return sum;
+}
+
+/**
+ * Ackley function (minimum 0 at origin)
+ * @param pos Array of coordinates
+ */
+static double ackley(double *pos){
+    double squares = 0.0;
+    double cosines = 0.0;
+    for(unsigned short c = 0; c < coords; c++){
+        squares += pos[c] * pos[c];
+        cosines += cos(2 * M_PI * pos[c]);
+    }
+    return -20.0 * exp(-0.2 * sqrt(squares / coords)) - exp(cosines / coords) + M_E + 20.0;
+}
+
+/**
+ * Griewank function (minimum 0 at origin)
+ * @param pos Array of coordinates
+ */
+static double griewank(double *pos){
+    double sum = 0.0;
+    double product = 1.0;
+    for(unsigned short c = 0; c < coords; c++){
+        sum += pos[c] * pos[c];
+        product *= cos(pos[c] / sqrt(c + 1.0));
+    }
+    return 1.0 + sum / 4000.0 - product;
+}
+
+/**
+ * Benchmarked function
+ */
+typedef struct {
+    const char *name;   //< Name of the function
+    funcndim function;  //< The function
+    double bound;       //< Every coordinate is in <-bound, bound>
+} TBenchFunc;
+
+static const TBenchFunc functions[] = {
+    {"sphere", sphere, 100.0},
+    {"rastrigin", rastrigin, 5.12},
+    {"rosenbrock", rosenbrock, 30.0},
+    {"ackley", ackley, 32.768},
+    {"griewank", griewank, 600.0}
+};
+
+// Header-only optimizers with inlined objective for each benchmarked function (see pso_static.h)
+#define PSO_STATIC_NAME inline_sphere
+#define PSO_STATIC_DIMENSIONS 3
+#define PSO_STATIC_OBJECTIVE(pos) sphere(pos)
+#define PSO_STATIC_FITNESS(a, b) ((a) < (b))
+#define PSO_STATIC_LINKAGE static
+#include "pso_static.h"
+
+#define PSO_STATIC_NAME inline_rastrigin
+#define PSO_STATIC_DIMENSIONS 3
+#define PSO_STATIC_OBJECTIVE(pos) rastrigin(pos)
+#define PSO_STATIC_FITNESS(a, b) ((a) < (b))
+#define PSO_STATIC_LINKAGE static
+#include "pso_static.h"
+
+#define PSO_STATIC_NAME inline_rosenbrock
+#define PSO_STATIC_DIMENSIONS 3
+#define PSO_STATIC_OBJECTIVE(pos) rosenbrock(pos)
+#define PSO_STATIC_FITNESS(a, b) ((a) < (b))
+#define PSO_STATIC_LINKAGE static
+#include "pso_static.h"
+
+#define PSO_STATIC_NAME inline_ackley
+#define PSO_STATIC_DIMENSIONS 3
+#define PSO_STATIC_OBJECTIVE(pos) ackley(pos)
+#define PSO_STATIC_FITNESS(a, b) ((a) < (b))
+#define PSO_STATIC_LINKAGE static
+#include "pso_static.h"
+
+#define PSO_STATIC_NAME inline_griewank
+#define PSO_STATIC_DIMENSIONS 3
+#define PSO_STATIC_OBJECTIVE(pos) griewank(pos)
+#define PSO_STATIC_FITNESS(a, b) ((a) < (b))
+#define PSO_STATIC_LINKAGE static
+#include "pso_static.h"
+
+/**
+ * 3 dimensional adapter of the benchmarked function
+ * @param x x coordinate
+ * @param y y coordinate
+ */
+static double active3dim(double x, double y){
+    double pos[2] = {x, y};
+    return active(pos);
+}
+
+/**
+ * 3 dimensional batch adapter of the benchmarked function (see func3dim_batch)
+ */
+static void active3dim_batch(const double *x, const double *y, unsigned int amount, double *values, void *data){
+    (void)data;
+    for(unsigned int a = 0; a < amount; a++){
+        values[a] = active3dim(x[a], y[a]);
+    }
+}
+
+/**
+ * Batch adapter of the benchmarked function (see funcndim_batch)
+ */
+static void active_batch(const double *positions, size_t stride, unsigned short amount_coords, unsigned int amount, double *values, void *data){
+    (void)data;
+    double pos[MAX_COORDS];
+    for(unsigned int a = 0; a < amount; a++){
+        for(unsigned short c = 0; c < amount_coords; c++){
+            pos[c] = positions[c*stride + a];
+        }
+        values[a] = active(pos);
+    }
+}
+
+/**
+ * Parameters of one benchmarked run
+ */
+typedef struct {
+    double (*bounds)[2];       //< Bounds of the function
+    unsigned int particle_am;  //< The amount of particles
+    unsigned int threads;      //< The amount of threads
+    unsigned long max_iter;    //< The amount of iterations
+    uint64_t seed;             //< Seed of the run
+    TPSOOptimizer *opt;        //< Reused optimizer (for entries using it)
+} TBenchRun;
+
+/**
+ * Runs entry point once
+ * @return The best found value
+ */
+typedef double (* bench_func)(const TBenchRun *run);
+
+/**
+ * Benchmarked entry point
+ */
+typedef struct {
+    const char *name;           //< Name of the entry point
+    bench_func run;             //< Function running the entry point
+    unsigned short coords;      //< The only supported amount of coordinates (0 for any)
+    unsigned int particle_am;   //< The only supported amount of particles (0 for any)
+    bool threaded;              //< If the entry point uses more threads
+    bool reused;                //< If the entry point uses optimizer created before the measurement
+} TBenchEntry;
+
+/**
+ * Creates configuration of a run
+ * @param run Run
+ * @return Configuration
+ */
+static TPSOConfig run_config(const TBenchRun *run){
+    TPSOConfig config;
+    pso_config_default(&config);
+    config.particle_am = run->particle_am;
+    config.max_iter = run->max_iter;
+    config.threads = run->threads;
+    config.seed = run->seed;
+    config.use_seed = true;
+    config.mode = PSO_MODE_MINIMIZE;
+    return config;
+}
+
+/**
+ * Returns value of best position and frees it
+ * @param best_pos Best position returned by entry point
+ */
+static double value_of(double *best_pos){
+    if(!best_pos){
+        return NAN;
+    }
+    double value = active(best_pos);
+    free(best_pos);
+    return value;
+}
+
+static double run_pso3dim(const TBenchRun *run){
+    double *best = pso3dim(active3dim, run->bounds, pso_less, run->particle_am, run->max_iter);
+    return value_of(best);
+}
+
+static double run_pso3dim_static(const TBenchRun *run){
+    TPSOxy best = pso3dim_static(active3dim, run->bounds, pso_less, run->max_iter);
+    return active3dim(best.x, best.y);
+}
+
+static double run_pso3dim_static_opt(const TBenchRun *run){
+    TPSOxy best = pso3dim_static_opt(active3dim, run->bounds, pso_less, run->max_iter);
+    return active3dim(best.x, best.y);
+}
+
+static double run_pso3dim_inline(const TBenchRun *run){
+    TPSORng rng;
+    double best[2];
+    pso_rng_seed(&rng, run->seed);
+    double (* const inlined[])(double [2][2], unsigned long, TPSORng *, double [2]) = {
+        inline_sphere, inline_rastrigin, inline_rosenbrock, inline_ackley, inline_griewank
+    };
+    for(size_t f = 0; f < sizeof(functions)/sizeof(functions[0]); f++){
+        if(functions[f].function == active){
+            return inlined[f](run->bounds, run->max_iter, &rng, best);
+        }
+    }
+    return NAN;
+}
+
+static double run_pso3dim_batch(const TBenchRun *run){
+    double *best = pso3dim_batch(active3dim_batch, NULL, run->bounds, pso_less, run->particle_am, run->max_iter);
+    return value_of(best);
+}
+
+static double run_pso4dim_static(const TBenchRun *run){
+    TPSORng rng;
+    double best[3];
+    pso_rng_seed(&rng, run->seed);
+    return pso4dim_static(active, run->bounds, pso_less, run->max_iter, &rng, best);
+}
+
+static double run_pso6dim_static(const TBenchRun *run){
+    TPSORng rng;
+    double best[5];
+    pso_rng_seed(&rng, run->seed);
+    return pso6dim_static(active, run->bounds, pso_less, run->max_iter, &rng, best);
+}
+
+static double run_pso8dim_static(const TBenchRun *run){
+    TPSORng rng;
+    double best[7];
+    pso_rng_seed(&rng, run->seed);
+    return pso8dim_static(active, run->bounds, pso_less, run->max_iter, &rng, best);
+}
+
+static double run_psondim(const TBenchRun *run){
+    return value_of(psondim(active, run->bounds, coords + 1, pso_less, run->particle_am, run->max_iter));
+}
+
+static double run_psondim_soa(const TBenchRun *run){
+    return value_of(psondim_soa(active, run->bounds, coords + 1, pso_less, run->particle_am, run->max_iter));
+}
+
+static double run_psondim_batch(const TBenchRun *run){
+    return value_of(psondim_batch(active_batch, NULL, run->bounds, coords + 1, pso_less, run->particle_am, run->max_iter));
+}
+
+static double run_psondim_parallel(const TBenchRun *run){
+    return value_of(psondim_parallel(active, run->bounds, coords + 1, pso_less, run->particle_am, run->max_iter, run->threads, run->seed));
+}
+
+static double run_psondim_async(const TBenchRun *run){
+    TPSOConfig config = run_config(run);
+    config.async = true;
+    TPSOResult result = {NULL};
+    return value_of(psondim_config(active, run->bounds, coords + 1, pso_less, &config, &result));
+}
+
+static double run_psondim_islands(const TBenchRun *run){
+    // Swarm is split between islands, so that the budget stays the same
+    TPSOConfig config = run_config(run);
+    config.islands = run->threads;
+    config.particle_am = run->particle_am / run->threads > 0 ? run->particle_am / run->threads : 1;
+    TPSOResult result = {NULL};
+    return value_of(psondim_islands(active, run->bounds, coords + 1, pso_less, &config, &result));
+}
+
+static double run_pso_run(const TBenchRun *run){
+    TPSOResult result = {NULL};
+    pso_run(run->opt, active, run->bounds, pso_less, &result);
+    return result.best_value;
+}
+
+static const TBenchEntry entries[] = {
+    {"pso3dim", run_pso3dim, 2, 0, false, false},
+    {"pso3dim_static", run_pso3dim_static, 2, PSO3DIM_STATIC_PARTICLES, false, false},
+    {"pso3dim_static_opt", run_pso3dim_static_opt, 2, PSO3DIM_STATIC_PARTICLES, false, false},
+    {"pso3dim_inline", run_pso3dim_inline, 2, PSO3DIM_STATIC_PARTICLES, false, false},
+    {"pso3dim_batch", run_pso3dim_batch, 2, 0, false, false},
+    {"pso4dim_static", run_pso4dim_static, 3, PSO3DIM_STATIC_PARTICLES, false, false},
+    {"pso6dim_static", run_pso6dim_static, 5, PSO3DIM_STATIC_PARTICLES, false, false},
+    {"pso8dim_static", run_pso8dim_static, 7, PSO3DIM_STATIC_PARTICLES, false, false},
+    {"psondim", run_psondim, 0, 0, false, false},
+    {"psondim_soa", run_psondim_soa, 0, 0, false, false},
+    {"psondim_batch", run_psondim_batch, 0, 0, false, false},
+    {"psondim_parallel", run_psondim_parallel, 0, 0, true, false},
+    {"psondim_async", run_psondim_async, 0, 0, true, false},
+    {"psondim_islands", run_psondim_islands, 0, 0, true, false},
+    {"pso_run", run_pso_run, 0, 0, true, true}
+};
+
+/**
+ * Output formats
+ */
+typedef enum {
+    FORMAT_TEXT,
+    FORMAT_CSV,
+    FORMAT_JSON
+} TFormat;
+
+/**
+ * Measurement of one combination
+ */
+typedef struct {
+    const TBenchEntry *entry;   //< Entry point
+    const TBenchFunc *func;     //< Function
+    unsigned int particle_am;   //< The amount of particles
+    unsigned int threads;       //< The amount of threads
+    unsigned long max_iter;     //< The amount of iterations
+    unsigned long evaluations;  //< The amount of function evaluations of one run
+    double median;              //< Median time of one run in seconds
+    double best_median;         //< Median of the best found values
+    double best_min;            //< The best of the best found values
+} TMeasurement;
+
+/**
+ * Compares doubles for qsort
+ */
+static int compare_doubles(const void *a, const void *b){
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Computes median of array (array is sorted)
+ * @param values Array
+ * @param n Length of the array
+ */
+static double median(double *values, unsigned int n){
+    qsort(values, n, sizeof(double), compare_doubles);
+    return n % 2 ? values[n / 2] : 0.5 * (values[n / 2 - 1] + values[n / 2]);
+}
+
+/**
+ * Computes seconds between 2 times
+ */
+static double seconds(struct timespec *begin, struct timespec *end){
+    return (double)(end->tv_sec - begin->tv_sec) + (double)(end->tv_nsec - begin->tv_nsec) * 1e-9;
+}
+
+/**
+ * Measures one combination
+ * @param m Measurement (entry, function, particles and threads are set)
+ * @param budget The amount of function evaluations of one run
+ * @param reps The amount of repetitions
+ * @return false if entry point could not be run
+ */
+static bool measure(TMeasurement *m, unsigned long budget, unsigned int reps){
+    double bounds[MAX_COORDS][2];
+    for(unsigned short c = 0; c < coords; c++){
+        bounds[c][0] = -m->func->bound;
+        bounds[c][1] = m->func->bound;
+    }
+    active = m->func->function;
+    m->max_iter = budget / m->particle_am > 0 ? budget / m->particle_am : 1;
+    m->evaluations = m->max_iter * m->particle_am;
+
+    TBenchRun run = {bounds, m->particle_am, m->threads, m->max_iter, 0, NULL};
+    if(m->entry->reused){
+        TPSOConfig config = run_config(&run);
+        run.opt = pso_create(coords + 1, &config);
+        if(!run.opt){
+            return false;
+        }
+    }
+    double times[MAX_REPS];
+    double values[MAX_REPS];
+    for(unsigned int r = 0; r < reps; r++){
+        // Entry points without seed parameter use the global one
+        run.seed = r + 1;
+        pso_init_seed(run.seed);
+        struct timespec begin, end;
+        clock_gettime(CLOCK_MONOTONIC, &begin);
+        values[r] = m->entry->run(&run);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        times[r] = seconds(&begin, &end);
+    }
+    pso_destroy(run.opt);
+    m->median = median(times, reps);
+    m->best_median = median(values, reps);
+    // Values are sorted by median
+    m->best_min = values[0];
+    return true;
+}
+
+/**
+ * Prints header of the output
+ * @param format Format
+ */
+static void print_header(TFormat format){
+    if(format == FORMAT_CSV){
+        printf("entry,function,dimensions,particles,threads,iterations,evaluations,median_s,iteration_us,evaluations_per_s,best_median,best_min\n");
+    }
+    else if(format == FORMAT_JSON){
+        printf("[\n");
+    }
+    else{
+        printf("%-20s %-11s %4s %6s %3s %8s %12s %12s %14s %14s\n", "entry", "function", "dims", "parts", "thr",
+               "iters", "median_s", "iter_us", "evals/s", "best_median");
+    }
+}
+
+/**
+ * Prints one measurement
+ * @param m Measurement
+ * @param format Format
+ * @param first If this is the 1st printed measurement
+ */
+static void print_measurement(const TMeasurement *m, TFormat format, bool first){
+    double iteration_us = m->median / m->max_iter * 1e6;
+    double rate = m->median > 0.0 ? m->evaluations / m->median : 0.0;
+    if(format == FORMAT_CSV){
+        printf("%s,%s,%u,%u,%u,%lu,%lu,%.9g,%.6g,%.6g,%.9g,%.9g\n", m->entry->name, m->func->name, coords + 1, m->particle_am,
+               m->threads, m->max_iter, m->evaluations, m->median, iteration_us, rate, m->best_median, m->best_min);
+    }
+    else if(format == FORMAT_JSON){
+        printf("%s  {\"entry\": \"%s\", \"function\": \"%s\", \"dimensions\": %u, \"particles\": %u, \"threads\": %u, "
+               "\"iterations\": %lu, \"evaluations\": %lu, \"median_s\": %.9g, \"iteration_us\": %.6g, "
+               "\"evaluations_per_s\": %.6g, \"best_median\": %.9g, \"best_min\": %.9g}",
+               first ? "" : ",\n", m->entry->name, m->func->name, coords + 1, m->particle_am, m->threads, m->max_iter,
+               m->evaluations, m->median, iteration_us, rate, m->best_median, m->best_min);
+    }
+    else{
+        printf("%-20s %-11s %4u %6u %3u %8lu %12.6f %12.3f %14.0f %14.6g\n", m->entry->name, m->func->name, coords + 1,
+               m->particle_am, m->threads, m->max_iter, m->median, iteration_us, rate, m->best_median);
+    }
+    fflush(stdout);
+}
+
+/**
+ * Parses comma separated list of positive numbers
+ * @param text Text of the list
+ * @param list Array for the numbers (MAX_LIST values)
+ * @return The amount of parsed numbers (0 if the list is invalid)
+ */
+static unsigned int parse_list(const char *text, unsigned int *list){
+    unsigned int n = 0;
+    while(*text && n < MAX_LIST){
+        char *end;
+        unsigned long value = strtoul(text, &end, 10);
+        if(end == text || value == 0){
+            return 0;
+        }
+        list[n++] = (unsigned int)value;
+        text = *end == ',' ? end + 1 : end;
+        if(*end && *end != ','){
+            return 0;
+        }
+    }
+    return n;
+}
+
+int main(int argc, char *argv[]){
+    TFormat format = FORMAT_TEXT;
+    unsigned int reps = 5;
+    unsigned long budget = 20000;
+    unsigned int dims[MAX_LIST] = {3, 4, 6, 8, 11};
+    unsigned int dims_am = 5;
+    unsigned int particles[MAX_LIST] = {20, 80};
+    unsigned int particles_am = 2;
+    unsigned int threads[MAX_LIST] = {1, 4};
+    unsigned int threads_am = 2;
+    const char *entry_filter = "";
+    const char *func_filter = "";
+
+    int opt;
+    while((opt = getopt(argc, argv, "f:r:b:d:p:t:e:F:")) != -1){
+        switch(opt){
+            case 'f':
+                format = strcmp(optarg, "csv") == 0 ? FORMAT_CSV : (strcmp(optarg, "json") == 0 ? FORMAT_JSON : FORMAT_TEXT);
+                break;
+            case 'r':
+                reps = (unsigned int)strtoul(optarg, NULL, 10);
+                break;
+            case 'b':
+                budget = strtoul(optarg, NULL, 10);
+                break;
+            case 'd':
+                dims_am = parse_list(optarg, dims);
+                break;
+            case 'p':
+                particles_am = parse_list(optarg, particles);
+                break;
+            case 't':
+                threads_am = parse_list(optarg, threads);
+                break;
+            case 'e':
+                entry_filter = optarg;
+                break;
+            case 'F':
+                func_filter = optarg;
+                break;
+            default:
+                dims_am = 0;
+                break;
+        }
+    }
+    if(reps == 0 || reps > MAX_REPS || budget == 0 || dims_am == 0 || particles_am == 0 || threads_am == 0){
+        fprintf(stderr, "Usage: %s [-f text|csv|json] [-r repetitions] [-b budget] [-d dimensions] [-p particles] [-t threads] [-e entry] [-F function]\n", argv[0]);
+        return 1;
+    }
+
+    print_header(format);
+    bool first = true;
+    for(unsigned int d = 0; d < dims_am; d++){
+        if(dims[d] < 2 || dims[d] - 1 > MAX_COORDS){
+            continue;
+        }
+        coords = dims[d] - 1;
+        for(size_t e = 0; e < sizeof(entries) / sizeof(entries[0]); e++){
+            const TBenchEntry *entry = &(entries[e]);
+            if((entry->coords && entry->coords != coords) || !strstr(entry->name, entry_filter)){
+                continue;
+            }
+            for(size_t f = 0; f < sizeof(functions) / sizeof(functions[0]); f++){
+                if(!strstr(functions[f].name, func_filter)){
+                    continue;
+                }
+                for(unsigned int p = 0; p < particles_am; p++){
+                    // Entries with fixed amount of particles are measured only once
+                    if(entry->particle_am && p > 0){
+                        break;
+                    }
+                    for(unsigned int t = 0; t < threads_am; t++){
+                        // Single threaded entries are measured only once (with 1 thread, whatever the list is)
+                        if(!entry->threaded && t > 0){
+                            break;
+                        }
+                        TMeasurement m = {entry, &(functions[f]), entry->particle_am ? entry->particle_am : particles[p], entry->threaded ? threads[t] : 1};
+                        if(measure(&m, budget, reps)){
+                            print_measurement(&m, format, first);
+                            first = false;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    if(format == FORMAT_JSON){
+        printf("\n]\n");
+    }
+    return 0;
+}
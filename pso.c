@@ -13,239 +13,4240 @@
  * Brno University of Technology
  */
 
+#ifdef __linux__
+#define _GNU_SOURCE  //< Needed for pinning threads to processors
+#endif
+#define _POSIX_C_SOURCE 200809L  //< Needed for POSIX threads and sysconf
+
 #include "pso.h"
+#include "pso_simd.h"
 #include "stddef.h"
 #include <stdlib.h>
+#include <stdint.h>
+#include <stdio.h>
 #include <time.h>
-#include <float.h>
 #include <string.h>
+#include <math.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sched.h>
+#endif
+#if defined(PSO_INSTRUMENT) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#endif
+
+#define SOA_ALIGNMENT 64  //< Alignment in bytes of every row in SoA swarm (size of a cache line)
+#define SOA_ROW_DOUBLES (SOA_ALIGNMENT/sizeof(double))  //< Amount of doubles fitting into one alignment block
+#define SOA_ROW_FLOATS (SOA_ALIGNMENT/sizeof(float))    //< Amount of floats fitting into one alignment block
+#define CACHE_PROBES 8  //< How many entries of evaluation cache are probed for a key
+#define CHECKPOINT_MAGIC 0x4b435350u  //< "PSCK" in little endian (checkpoint of different byte order does not match)
+#define CHECKPOINT_VERSION 2u         //< Version of checkpoint format
+
+#ifdef PSO_INSTRUMENT
+#define INSTRUMENT_BEGIN(ticks) uint64_t ticks = pso_instrument_ticks()  //< Starts measuring phase
+#define INSTRUMENT_END(phase, ticks) pso_instrument_phase(phase, pso_instrument_ticks() - (ticks))  //< Adds time since start to phase
+#else
+#define INSTRUMENT_BEGIN(ticks)
+#define INSTRUMENT_END(phase, ticks)
+#endif // PSO_INSTRUMENT
 
 /**
- * Macro for generating random double in passed in range.
- * Inspired by https://ubuntuforums.org/showthread.php?t=1717717&p=10618266#post10618266
- * 
+ * Swarm stored as structure of arrays (SoA)
+ * All arrays are parts of one contiguous aligned block of memory.
+ * Coordinates are stored row by row, so coordinate `c` of particle `p`
+ * is at index `c*stride + p` and every row starts at aligned address.
+ */
+typedef struct {
+    double *velocity;          //< Velocity for each dimension of each particle
+    double *position;          //< Position in each dimension of each particle
+    double *best_pos;          //< Best position of each particle
+    double *best_val;          //< Value of the best position of each particle
+    double *values;            //< Value of the current position of each particle
+    double *rand_p;            //< Cognitive random numbers for current iteration
+    double *rand_g;            //< Social random numbers for current iteration
+    double *rand_r;            //< Random numbers for reinitialized positions
+    double *coord_buf;         //< Buffers for passing coordinates of one particle to function (one per thread)
+    double *extents;           //< Minimum and maximum of each coordinate of particles of each thread
+    union {
+        double *nbest_pos;     //< Best position in neighborhood of each particle (used by local topologies)
+        double *pending;       //< Submitted position of each particle, its coordinates are next to each other (used by async runs)
+    };
+    union {
+        unsigned int *nbest_index; //< Particle with the best position in neighborhood of each particle
+        unsigned int *ready;       //< Ring queue of particles ready for evaluation (used by async runs)
+    };
+    unsigned int *links;       //< Random neighbors of each particle (links_am per particle)
+    unsigned int links_am;     //< The amount of random neighbors of each particle
+    double *best_viol;         //< Constraint violation of the best position of each particle
+    double *violation;         //< Constraint violation of the current position of each particle
+    double *constr;            //< Values of constraints at current positions (constr_am rows)
+    unsigned int constr_am;    //< The amount of constraints (0 if they are not used by current run)
+    double *caches;            //< Evaluation caches of all threads
+    unsigned int cache_am;     //< The amount of cache entries of each thread
+    void *arena;               //< Block of memory holding all the arrays
+    size_t stride;             //< Length of one row (particle amount rounded up to alignment)
+    unsigned int particle_am;  //< Amount of particles
+    unsigned short coords;     //< Amount of coordinates (dimensions - 1)
+} TSwarmSoA;
+
+/**
+ * Sizes of parts of SoA swarm
+ */
+typedef struct {
+    unsigned short coords;     //< Amount of coordinates (dimensions - 1)
+    unsigned int particle_am;  //< Amount of particles
+    unsigned int threads;      //< Amount of threads working with the swarm
+    unsigned int links_am;     //< Amount of random neighbors of each particle
+    unsigned int cache_am;     //< Amount of evaluation cache entries of each thread (power of 2 or 0)
+    unsigned int constr_am;    //< Amount of constraints
+} TSwarmShape;
+
+/**
+ * Evaluation cache of one thread
+ * Open addressing hash table keyed by quantized positions
+ */
+typedef struct {
+    uint64_t *tags;     //< Hash of key of each entry (0 for empty entry)
+    double *keys;       //< Quantized coordinates of each entry
+    double *values;     //< Function value of each entry
+    unsigned int mask;  //< The amount of entries - 1 (0 if there is no cache)
+    double scale;       //< Inverse of quantization step (0 for exact keys)
+} TEvalCache;
+
+/**
+ * Evaluator of the swarm positions
+ * Either function called for each particle or batch function called
+ * once for the whole swarm is used.
+ */
+typedef struct {
+    funcndim function;     //< Function called for each particle (when batch is NULL)
+    funcndim_batch batch;  //< Function called once for whole swarm
+    void *data;            //< Data passed to batch function
+    func3dim function3;    //< 3 dimensional function called for each particle (used instead of function if set)
+    submit_func submit;    //< Function submitting particles for evaluation by caller (async run, data is passed to it)
+} TEvaluator;
+
+/**
+ * Header of checkpoint file
+ * It is followed by the global best position, state of each worker (TCheckpointWorker),
+ * rows of velocities, positions, personal best positions and personal best values
+ * (as they are in the swarm arena), links of random topology and personal best
+ * constraint violations (if there are constraints).
+ * All values are stored in native byte order.
+ */
+typedef struct {
+    uint32_t magic;        //< CHECKPOINT_MAGIC
+    uint32_t version;      //< CHECKPOINT_VERSION
+    uint32_t coords;       //< Amount of coordinates (dimensions - 1)
+    uint32_t particle_am;  //< Amount of particles
+    uint32_t threads;      //< Amount of workers
+    uint32_t links_am;     //< Amount of random neighbors of each particle
+    uint32_t constr_am;    //< Amount of constraints
+    uint64_t stride;       //< Length of one swarm row
+    uint64_t iterations;   //< The amount of finished iterations
+    uint64_t improved;     //< Last iteration in which global best value improved
+    double best_value;     //< Global best value
+    double best_viol;      //< Constraint violation of global best
+    TPSORng rng;           //< Generator seeding workers of the next runs
+} TCheckpointHeader;
+
+/**
+ * State of one worker in checkpoint file
+ */
+typedef struct {
+    TPSORng rng;           //< Worker's generator
+    TRngLanes lanes;       //< Worker's generators for random coefficients
+    uint64_t evaluations;  //< The amount of function evaluations done by the worker
+    uint64_t cache_hits;   //< The amount of evaluations answered by worker's cache
+    uint64_t skipped;      //< The amount of evaluations skipped by the worker
+} TCheckpointWorker;
+
+/**
+ * Data for adapting 3 dimensional batch function to n dimensional batch function
+ */
+typedef struct {
+    func3dim_batch function;  //< Adapted function
+    void *data;               //< Data passed to adapted function
+} TBatch3dimAdapter;
+
+/**
+ * Gate in which created worker threads wait until all of them are created
+ */
+typedef struct {
+    pthread_mutex_t lock;  //< Held by creating thread until the threads can start
+    bool cancel;           //< Set when the threads should end without starting
+} TThreadGate;
+
+/**
+ * Worker of SoA swarm optimizer
+ * Every worker works only with its own range of particles
+ */
+typedef struct {
+    _Alignas(SOA_ALIGNMENT) TPSOOptimizer *run;  //< Optimizer this worker belongs to (aligned so workers do not share cache lines)
+    pthread_t thread;        //< Thread of the worker (unused for 1st worker, which runs in calling thread)
+    TPSORng rng;             //< Worker's own pseudo-random generator
+    TRngLanes lanes;         //< Worker's generators for random coefficients of whole range
+    double *coord_buf;       //< Worker's buffer for passing coordinates to function
+    double *extents;         //< Worker's minimum and maximum of each coordinate (2 values per coordinate)
+    unsigned int begin;      //< Index of the 1st particle of the worker
+    unsigned int end;        //< Index after the last particle of the worker
+    unsigned int best_index; //< Best particle of the worker from current iteration (end if none)
+    double best_value;       //< Value of the best particle of the worker
+    double best_viol;        //< Constraint violation of the best particle of the worker
+    unsigned long evaluations;  //< The amount of function evaluations done by the worker
+    unsigned long cache_hits;   //< The amount of evaluations answered by worker's cache
+    unsigned long skipped;      //< The amount of evaluations skipped at clearly infeasible positions
+    TEvalCache cache;           //< Worker's evaluation cache
+} TSwarmWorker;
+
+/**
+ * Mailbox through which island publishes its best particle
+ * Writer makes sequence odd before writing and even after it (seqlock),
+ * so readers never wait and they detect torn reads by changed sequence
+ */
+typedef struct {
+    _Alignas(SOA_ALIGNMENT) _Atomic unsigned long seq;  //< Sequence (odd while particle is written, 0 if nothing was published)
+    _Atomic double value;  //< Value of published particle
+    _Atomic double pos[];  //< Coordinates of published particle
+} TIslandMail;
+
+/**
+ * Island of island model
+ * Every island has its own optimizer with one worker running in island's thread
+ */
+typedef struct {
+    _Alignas(SOA_ALIGNMENT) TPSOOptimizer *opt;  //< Optimizer of the island (created by island's thread, so that its memory is local to island's processor)
+    pthread_t thread;           //< Thread of the island
+    TIslandMail *outbox;        //< Mailbox written by this island
+    TIslandMail *inbox;         //< Mailbox of the previous island
+    unsigned long seen;         //< Sequence of the last received particle
+    unsigned int index;         //< Index of the island
+    TPSOConfig config;          //< Configuration of the island
+    const TEvaluator *ev;       //< Evaluator of particle positions
+    double (*bounds)[2];        //< Function bounds
+    fit_func fitness;           //< Fitness function
+    unsigned short coords;      //< How many coordinates particles have (dimensions - 1)
+    TPSOResult result;          //< Result of the island
+} TIsland;
+
+/**
+ * Single precision swarm stored as structure of arrays
+ * Coordinates are floats, so that rows take half of the memory of TSwarmSoA rows
+ * and vectors hold twice as many of them. Function values stay doubles.
+ */
+typedef struct {
+    float *velocity;           //< Velocity for each dimension of each particle
+    float *position;           //< Position in each dimension of each particle
+    float *best_pos;           //< Best position of each particle
+    float *rand_p;             //< Cognitive random numbers for current iteration
+    float *rand_g;             //< Social random numbers for current iteration
+    float *rand_r;             //< Random numbers for reinitialized positions
+    double *best_val;          //< Value of the best position of each particle
+    double *values;            //< Value of the current position of each particle
+    void *arena;               //< Block of memory holding all the arrays
+    size_t stride;             //< Length of one row (particle amount rounded up to alignment of floats)
+    unsigned int particle_am;  //< Amount of particles
+    unsigned short coords;     //< Amount of coordinates (dimensions - 1)
+} TSwarmFloat;
+
+typedef struct TFloatRun TFloatRun;
+
+/**
+ * Worker of single precision swarm
+ * Every worker works only with its own range of particles
+ */
+typedef struct {
+    _Alignas(SOA_ALIGNMENT) TFloatRun *run;  //< Run this worker belongs to (aligned so workers do not share cache lines)
+    pthread_t thread;        //< Thread of the worker (unused for 1st worker, which runs in calling thread)
+    TPSORng rng;             //< Worker's own pseudo-random generator
+    TRngLanes lanes;         //< Worker's generators for random coefficients of whole range
+    unsigned int begin;      //< Index of the 1st particle of the worker
+    unsigned int end;        //< Index after the last particle of the worker
+    unsigned int best_index; //< Best particle of the worker from current iteration (end if none)
+    double best_value;       //< Value of the best particle of the worker
+    unsigned long evaluations;  //< The amount of function evaluations done by the worker
+} TFloatWorker;
+
+/**
+ * Run of single precision swarm
+ * Global best is kept in double precision
+ */
+struct TFloatRun {
+    TSwarmFloat swarm;          //< Optimized swarm
+    funcndim_batch_float function;  //< Batch function
+    void *data;                 //< Data passed to batch function
+    double (*bounds)[2];        //< Function bounds
+    fit_func fitness;           //< Fitness function
+    TPSOMode mode;              //< Comparison used by the run
+    const TPSOConfig *config;   //< Configuration
+    double *best_pos;           //< Global best position
+    double *vmax;               //< Velocity limit of each coordinate
+    double best_value;          //< Global best value
+    unsigned long improved;     //< Last iteration in which global best value improved
+    unsigned long iterations;   //< The amount of finished iterations
+    TPSOStop stop;              //< Reason for stopping (valid once stopping is set)
+    bool stopping;              //< Set when workers should stop after current iteration
+    struct timespec start;      //< Time when the run started
+    TFloatWorker *workers;      //< Array of workers
+    unsigned int threads;       //< Amount of workers
+    pthread_barrier_t barrier;  //< Barrier synchronizing workers between phases
+    TThreadGate gate;           //< Gate holding worker threads until they are all created
+};
+
+/**
+ * Bounded archive of non-dominated points (Pareto archive)
+ * Objectives are kept in rows (as values of the swarm) and members are at the start
+ * of arrays, so dominance checks go through memory linearly. Crowding is measured
+ * by adaptive grid over objective space, its cells are counted in hash table.
+ * The grid is fitted only when a point falls out of it (or the table is full),
+ * otherwise the counts are updated by each insertion and removal.
+ */
+typedef struct {
+    double *objectives;    //< Objective values of members, objective `k` of member `j` is at `k*row + j`
+    uint64_t *flags;       //< Result of dominance check of each member (used by archive_insert)
+    double *positions;     //< Coordinates of members, member after member
+    unsigned int *slots;   //< Slot of grid cell of each member in counting hash table
+    uint64_t *keys;        //< Cells in counting hash table (0 for empty slot)
+    unsigned int *counts;  //< The amount of members in each cell of counting hash table
+    double *grid_min;      //< Lower end of grid in each objective
+    double *grid_step;     //< Width of grid cell in each objective (0 if all members have the same value)
+    double *point;         //< Objective vector of inserted point (used by archive_insert)
+    unsigned int mask;     //< Size of counting hash table - 1
+    unsigned int used;     //< The amount of used slots of counting hash table
+    unsigned int hint;     //< Member which dominated the last rejected point (checked first)
+    unsigned int crowded;  //< Slot of the most crowded cell (valid only if crowded_valid)
+    bool crowded_valid;    //< If the most crowded cell is known
+    size_t row;            //< Length of objective rows (capacity rounded up)
+    unsigned int size;     //< The amount of members
+    unsigned int capacity; //< Maximal amount of members
+    unsigned int divisions;   //< Grid cells in each objective
+    unsigned short objectives_am;  //< The amount of objectives
+    unsigned short coords;    //< The amount of coordinates
+} TParetoArchive;
+
+/**
+ * Reusable SoA swarm optimizer (shared state of its runs)
+ * Swarm, workers and their threads are kept between runs.
+ */
+struct TPSOOptimizer {
+    TSwarmSoA swarm;            //< Optimized swarm
+    const TEvaluator *ev;       //< Evaluator of particle positions (of current run)
+    double (*bounds)[2];        //< Function bounds (of current run)
+    fit_func fitness;           //< Fitness function (of current run)
+    TPSOMode mode;              //< Comparison used by current run
+    unsigned int span;          //< Ring radius or width of von Neumann grid (of current run)
+    TPSOConfig config;          //< Configuration
+    TPSORng rng;                //< Generator seeding workers at the start of every run
+    double *best_pos;           //< Global best position
+    double *vmax;               //< Velocity limit of each coordinate (of current run)
+    double best_value;          //< Global best value
+    double best_viol;           //< Constraint violation of global best (0 if it is feasible)
+    unsigned long improved;     //< Last iteration in which global best value improved
+    unsigned long iterations;   //< The amount of finished iterations
+    TPSOStop stop;              //< Reason for stopping (valid once stopping is set)
+    bool stopping;              //< Set when workers should stop after current iteration
+    bool quit;                  //< Set when worker threads should end
+    bool async;                 //< If current run is asynchronous
+    bool resume;                //< If the next run continues from loaded checkpoint
+    bool filled;                //< If swarm holds particles left by the previous run
+    uint64_t init_key;          //< Key randomizing low-discrepancy initialization (of current run)
+    unsigned long checkpoints;  //< The amount of checkpoints written by current run
+    unsigned int head;          //< The 1st particle in queue of ready particles (async run)
+    unsigned int queued;        //< The amount of particles in queue of ready particles (async run)
+    unsigned int in_flight;     //< The amount of particles being evaluated (async run)
+    unsigned long issued;       //< The amount of evaluations started (async run)
+    unsigned long completed;    //< The amount of evaluations finished (async run)
+    struct timespec start;      //< Time when the run started
+    TSwarmWorker *workers;      //< Array of workers
+    TSwarmWorker single;        //< The only worker when 1 thread is used
+    unsigned int threads;       //< Amount of workers
+    unsigned int capacity;      //< The amount of particles the swarm is allocated for
+    unsigned int swarm_threads; //< The amount of threads the swarm has buffers for
+    unsigned int swarm_links;   //< The amount of random neighbors the swarm has space for
+    unsigned int swarm_cache;   //< The amount of cache entries of each thread the swarm has space for
+    unsigned int swarm_constr;  //< The amount of constraints the swarm has space for
+    unsigned short coords;      //< How many coordinates particles have (dimensions - 1)
+    void *region;               //< Part of caller buffer for workers and swarm (NULL if they are allocated)
+    size_t region_size;         //< Size of the region in bytes
+    pthread_barrier_t barrier;  //< Barrier synchronizing workers between phases
+    TThreadGate gate;           //< Gate holding worker threads until they are all created
+    pthread_mutex_t lock;       //< Lock of swarm and global best (async run)
+    pthread_cond_t wake;        //< Signaled when particle is ready or the run is finished (async run)
+    TIsland *island;            //< Island the optimizer belongs to (NULL if it is not part of island model)
+};
+
+_Static_assert(sizeof(TPSOOptimizer) + SOA_ALIGNMENT <= PSO_OPTIMIZER_SIZE, "PSO_OPTIMIZER_SIZE is too small");
+_Static_assert(sizeof(TSwarmWorker) <= PSO_WORKER_SIZE, "PSO_WORKER_SIZE is too small");
+
+static _Atomic uint64_t seed_counter = 0;  //< Seed for the next call without explicit seed
+
+#ifdef PSO_INSTRUMENT
+static _Atomic uint64_t stat_ticks[PSO_PHASES];             //< Ticks of each phase
+static _Atomic uint64_t stat_clamp[PSO_INSTRUMENT_COORDS];  //< Clamp hits of each coordinate
+static _Atomic uint64_t stat_iterations;                    //< The amount of iterations
+static iter_func iteration_callback = NULL;                 //< Function called after every iteration
+static void *callback_data = NULL;                          //< Data passed to iteration_callback
+
+/**
+ * Reads counters
+ * @param stats Counters are saved here
+ */
+void pso_instrument_stats(TPSOStats *stats){
+    for(int p = 0; p < PSO_PHASES; p++){
+        stats->ticks[p] = atomic_load(&(stat_ticks[p]));
+    }
+    for(int c = 0; c < PSO_INSTRUMENT_COORDS; c++){
+        stats->clamp_hits[c] = atomic_load(&(stat_clamp[c]));
+    }
+    stats->iterations = atomic_load(&stat_iterations);
+}
+
+/**
+ * Sets all counters to 0
+ */
+void pso_instrument_reset(){
+    for(int p = 0; p < PSO_PHASES; p++){
+        atomic_store(&(stat_ticks[p]), 0);
+    }
+    for(int c = 0; c < PSO_INSTRUMENT_COORDS; c++){
+        atomic_store(&(stat_clamp[c]), 0);
+    }
+    atomic_store(&stat_iterations, 0);
+}
+
+/**
+ * Sets function called after every iteration of every optimization
+ * @param callback Function (NULL to disable)
+ * @param data Data passed to the function
+ * @note It should not be changed while any optimization runs
+ */
+void pso_instrument_callback(iter_func callback, void *data){
+    iteration_callback = callback;
+    callback_data = data;
+}
+
+/**
+ * Reads time stamp counter (used by instrumented code)
+ * @return Current ticks
+ */
+uint64_t pso_instrument_ticks(){
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+#endif
+}
+
+/**
+ * Adds ticks to phase counter (used by instrumented code)
+ * @param phase Phase
+ * @param ticks Ticks
+ */
+void pso_instrument_phase(TPSOPhase phase, uint64_t ticks){
+    atomic_fetch_add_explicit(&(stat_ticks[phase]), ticks, memory_order_relaxed);
+}
+
+/**
+ * Adds clamp hits of coordinate (used by instrumented code)
+ * @param coord Coordinate
+ * @param hits The amount of particles left on a bound
+ */
+void pso_instrument_clamp(unsigned short coord, uint64_t hits){
+    unsigned short c = coord < PSO_INSTRUMENT_COORDS ? coord : PSO_INSTRUMENT_COORDS - 1;
+    atomic_fetch_add_explicit(&(stat_clamp[c]), hits, memory_order_relaxed);
+}
+
+/**
+ * Reports finished iteration (used by instrumented code)
+ * @param i Finished iteration
+ * @param best_value The best value
+ * @param best_pos The best position
+ */
+void pso_instrument_iteration(unsigned long i, double best_value, const double *best_pos){
+    atomic_fetch_add_explicit(&stat_iterations, 1, memory_order_relaxed);
+    if(iteration_callback){
+        iteration_callback(i, best_value, best_pos, callback_data);
+    }
+}
+#endif // PSO_INSTRUMENT
+
+#ifdef ASSERT_ALLOCATION
+/**
+ * Error handler function
+ * @note This function is weak and can be redifined elsewhere
+ */
+_Noreturn void __attribute__((weak)) error_handler(){
+    exit(1);
+}
+#endif //ASSERT_ALLOCATION
+
+/**
+ * Rotates 64 bit value left
+ * @param x Value to be rotated
+ * @param k By how many bits
+ */
+static inline uint64_t rotl(const uint64_t x, int k){
+    return (x << k) | (x >> (64 - k));
+}
+
+/**
+ * Generates next 64 bit number
+ * @param rng Generator state
+ */
+static inline uint64_t rng_next(TPSORng *rng){
+    uint64_t *s = rng->s;
+    const uint64_t result = rotl(s[1] * 5, 7) * 9;
+    const uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    return result;
+}
+
+/**
+ * Generates random double in passed in range
+ * This is inlined version of pso_rng_double used in hot loops
+ * @param rng Generator state
+ * @param min Minimal value of generated number
+ * @param max Maximal value of generated number
+ * @return random double in range of <min, max)
+ */
+static inline double rng_double(TPSORng *rng, double min, double max){
+    // 53 upper bits are used as mantissa
+    return min + (rng_next(rng) >> 11) * 0x1.0p-53 * (max - min);
+}
+
+/**
+ * Generates normally distributed double with mean 0 and standard deviation 1
+ * Box-Muller transform is used (1 - u is never 0, so its logarithm is finite)
+ * @param rng Generator
+ * @return Generated double
+ */
+static double rng_gauss(TPSORng *rng){
+    double u = rng_double(rng, 0, 1);
+    double v = rng_double(rng, 0, 1);
+    return sqrt(-2.0 * log(1.0 - u)) * cos(6.283185307179586 * v);
+}
+
+/**
+ * Mixes bits of 64 bit value (finalizer of splitmix64)
+ * @param z Value
+ * @return Mixed value
+ */
+static inline uint64_t splitmix64(uint64_t z){
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * Seeds pseudo-random generator
+ * Seed is expanded using splitmix64, so that any seed (even 0) gives good state
+ * @param rng Generator state
+ * @param seed Seed
+ */
+void pso_rng_seed(TPSORng *rng, uint64_t seed){
+    for(int i = 0; i < 4; i++){
+        rng->s[i] = splitmix64(seed += 0x9e3779b97f4a7c15ULL);
+    }
+}
+
+/**
+ * Moves pseudo-random generator 2^128 numbers forward
+ * This can be used to create non-overlapping sequences for multiple threads
+ * @param rng Generator state
+ */
+void pso_rng_jump(TPSORng *rng){
+    static const uint64_t JUMP[] = {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL};
+    uint64_t s[4] = {0, 0, 0, 0};
+    for(int i = 0; i < 4; i++){
+        for(int b = 0; b < 64; b++){
+            if(JUMP[i] & (1ULL << b)){
+                for(int k = 0; k < 4; k++){
+                    s[k] ^= rng->s[k];
+                }
+            }
+            rng_next(rng);
+        }
+    }
+    memcpy(rng->s, s, sizeof(s));
+}
+
+/**
+ * Generates random 64 bit number
+ * @param rng Generator state
+ * @return random number
+ */
+uint64_t pso_rng_next(TPSORng *rng){
+    return rng_next(rng);
+}
+
+/**
+ * Generates random double in passed in range
+ * @param rng Generator state
  * @param min Minimal value of generated number
  * @param max Maximal value of generated number
- * @return random double in range of <min, max>
- * @note casts are done so that this function can take also integers and 
- *       parentheses are included in case of arguments being expressions.
+ * @return random double in range of <min, max)
+ */
+double pso_rng_double(TPSORng *rng, double min, double max){
+    return rng_double(rng, min, max);
+}
+
+/**
+ * Creates seed for calls which do not get one from the caller
+ * Counter set in pso_init is incremented atomically, so concurrent
+ * calls get different seeds without any lock
+ */
+static uint64_t default_seed(){
+    return atomic_fetch_add(&seed_counter, 1);
+}
+
+/**
+ * Fitness function for minimization (recognized by the engine, which then does not call it)
+ * @param a 1st value
+ * @param b 2nd value
+ * @return true if a is less than b
+ */
+bool pso_less(double a, double b){
+    return a < b;
+}
+
+/**
+ * Fitness function for maximization (recognized by the engine, which then does not call it)
+ * @param a 1st value
+ * @param b 2nd value
+ * @return true if a is greater than b
+ */
+bool pso_greater(double a, double b){
+    return a > b;
+}
+
+/**
+ * Seeds pseudo-random generator as calls without explicit seed do
+ * @param rng Generator state
+ */
+void pso_rng_default(TPSORng *rng){
+    pso_rng_seed(rng, default_seed());
+}
+
+/**
+ * Initializer function for PSO module
+ * @warning This function should be called only once before any other PSO function is called
+ * @note This function sets seed used by calls without explicit seed from current time
+ */
+void pso_init(){
+    pso_init_seed((uint64_t)time(NULL));
+}
+
+/**
+ * Initializer function for PSO module with explicit seed
+ * Calls without explicit seed are then reproducible (when done in the same order)
+ * @param seed Seed from which seeds of the calls are derived
+ */
+void pso_init_seed(uint64_t seed){
+    atomic_store(&seed_counter, seed);
+}
+
+// Fixed size optimizers for often used dimensions (see pso_static.h)
+#define PSO_STATIC_NAME pso4dim_static
+#define PSO_STATIC_DIMENSIONS 4
+#include "pso_static.h"
+
+#define PSO_STATIC_NAME pso6dim_static
+#define PSO_STATIC_DIMENSIONS 6
+#include "pso_static.h"
+
+#define PSO_STATIC_NAME pso8dim_static
+#define PSO_STATIC_DIMENSIONS 8
+#include "pso_static.h"
+
+/**
+ * Rounds up amount of doubles so that array of them fills whole alignment blocks
+ * @param amount Amount of doubles
+ * @return Rounded up amount
+ */
+static size_t soa_round_up(size_t amount){
+    return (amount + SOA_ROW_DOUBLES - 1) / SOA_ROW_DOUBLES * SOA_ROW_DOUBLES;
+}
+
+/**
+ * Computes the amount of random neighbors of each particle
+ * @param config Configuration
+ * @return The amount of random neighbors (0 for other than random topology)
+ */
+static unsigned int topology_links(const TPSOConfig *config){
+    if(config->topology != PSO_TOPOLOGY_RANDOM){
+        return 0;
+    }
+    return config->neighbors > 0 ? config->neighbors : 3;
+}
+
+/**
+ * Computes the amount of evaluation cache entries of each thread
+ * @param config Configuration
+ * @return Cache size rounded up to power of 2 (0 if cache is disabled)
+ */
+static unsigned int cache_entries(const TPSOConfig *config){
+    if(config->cache_size == 0){
+        return 0;
+    }
+    unsigned int entries = 1;
+    while(entries < config->cache_size && entries < (1u << 31)){
+        entries <<= 1;
+    }
+    return entries;
+}
+
+/**
+ * Computes the amount of constraints of a run
+ * @param config Configuration
+ * @return The amount of inequality and equality constraints (0 if there is no constraints function)
+ */
+static unsigned int constraint_count(const TPSOConfig *config){
+    return config->constraints ? (unsigned int)config->ineq_am + config->eq_am : 0;
+}
+
+/**
+ * Computes size of memory block for SoA swarm
+ * @param shape Sizes of swarm parts
+ * @return Size in bytes (multiple of alignment)
+ */
+static size_t soa_arena_size(const TSwarmShape *shape){
+    size_t stride = soa_round_up(shape->particle_am);
+    size_t coords = shape->coords;
+    // Velocity, position, best position and neighborhood best rows for each coordinate,
+    //  best values, current values and random numbers rows, coordinate buffers and extents
+    size_t doubles = stride * (4 * coords + 5) + 3 * soa_round_up(coords) * shape->threads;
+    // Violation rows and row of each constraint
+    doubles += shape->constr_am > 0 ? stride * (shape->constr_am + 2) : 0;
+    // Neighborhood best indices and random neighbors (each row of them is aligned too)
+    size_t indices = (stride + stride * shape->links_am) * sizeof(unsigned int);
+    // Evaluation cache of each thread (tags, keys and values of all entries)
+    size_t caches = (size_t)shape->cache_am * (coords + 2) * shape->threads;
+    return sizeof(double) * (doubles + caches) + (indices + SOA_ALIGNMENT - 1) / SOA_ALIGNMENT * SOA_ALIGNMENT;
+}
+
+/**
+ * Places SoA swarm into aligned block of memory
+ * @param s Swarm to be placed
+ * @param arena Block of memory with size given by soa_arena_size
+ * @param shape Sizes of swarm parts
+ */
+static void layout_swarm_soa(TSwarmSoA *s, double *arena, const TSwarmShape *shape){
+    size_t stride = soa_round_up(shape->particle_am);
+    unsigned short coords = shape->coords;
+    unsigned int threads = shape->threads;
+    s->arena = arena;
+    s->stride = stride;
+    s->particle_am = shape->particle_am;
+    s->coords = coords;
+    s->velocity = arena;
+    s->position = s->velocity + stride * coords;
+    s->best_pos = s->position + stride * coords;
+    s->best_val = s->best_pos + stride * coords;
+    s->values = s->best_val + stride;
+    s->rand_p = s->values + stride;
+    s->rand_g = s->rand_p + stride;
+    s->rand_r = s->rand_g + stride;
+    s->coord_buf = s->rand_r + stride;
+    s->extents = s->coord_buf + soa_round_up(coords) * threads;
+    s->nbest_pos = s->extents + 2 * soa_round_up(coords) * threads;
+    // Violation rows are there only when constraints are used (pointers are not used otherwise)
+    size_t violation_rows = shape->constr_am > 0 ? shape->constr_am + 2 : 0;
+    s->best_viol = s->nbest_pos + stride * coords;
+    s->violation = s->best_viol + stride;
+    s->constr = s->violation + stride;
+    s->constr_am = shape->constr_am;
+    s->nbest_index = (unsigned int *)(s->best_viol + stride * violation_rows);
+    s->links = s->nbest_index + stride;
+    s->links_am = shape->links_am;
+    size_t indices = (stride + stride * shape->links_am) * sizeof(unsigned int);
+    s->caches = (double *)((char *)s->nbest_index + (indices + SOA_ALIGNMENT - 1) / SOA_ALIGNMENT * SOA_ALIGNMENT);
+    s->cache_am = shape->cache_am;
+}
+
+/**
+ * Allocates SoA swarm in one aligned block of memory
+ * @param s Swarm to be allocated
+ * @param shape Sizes of swarm parts
+ */
+static void alloc_swarm_soa(TSwarmSoA *s, const TSwarmShape *shape){
+    double *arena = aligned_alloc(SOA_ALIGNMENT, soa_arena_size(shape));
+#ifdef ASSERT_ALLOCATION
+    if(!arena){
+        error_handler();
+    }
+#endif // ASSERT_ALLOCATION
+    s->arena = NULL;
+    if(arena){
+        layout_swarm_soa(s, arena, shape);
+    }
+}
+
+/**
+ * Frees SoA swarm
+ * @param s Swarm to be freed
+ */
+static void free_swarm_soa(TSwarmSoA *s){
+    free(s->arena);
+    s->arena = NULL;
+}
+
+/**
+ * Primitive polynomial and initial direction numbers of one Sobol coordinate
+ * (coordinates 2 to SOBOL_COORDS of Joe and Kuo's table, the 1st coordinate is van der Corput sequence)
+ */
+typedef struct {
+    uint8_t degree;  //< Degree of the polynomial
+    uint8_t poly;    //< Inner coefficients of the polynomial
+    uint8_t m[7];    //< Initial direction numbers
+} TSobolPoly;
+
+#define SOBOL_COORDS 21  //< Amount of coordinates with Sobol direction numbers (others use Latin hypercube)
+
+static const TSobolPoly SOBOL_POLYS[SOBOL_COORDS - 1] = {
+    {1, 0, {1}},
+    {2, 1, {1, 3}},
+    {3, 1, {1, 3, 1}},
+    {3, 2, {1, 1, 1}},
+    {4, 1, {1, 1, 3, 3}},
+    {4, 4, {1, 3, 5, 13}},
+    {5, 2, {1, 1, 5, 5, 17}},
+    {5, 4, {1, 1, 5, 5, 5}},
+    {5, 7, {1, 1, 7, 11, 19}},
+    {5, 11, {1, 1, 5, 1, 1}},
+    {5, 13, {1, 1, 1, 3, 11}},
+    {5, 14, {1, 3, 5, 5, 31}},
+    {6, 1, {1, 3, 3, 9, 7, 49}},
+    {6, 13, {1, 1, 1, 15, 21, 21}},
+    {6, 16, {1, 3, 1, 13, 27, 49}},
+    {6, 19, {1, 1, 1, 15, 7, 5}},
+    {6, 22, {1, 3, 1, 15, 13, 25}},
+    {6, 25, {1, 1, 5, 5, 19, 61}},
+    {7, 1, {1, 3, 7, 11, 23, 15, 103}},
+    {7, 4, {1, 3, 7, 13, 13, 15, 69}}
+};
+
+/**
+ * Computes direction numbers of Sobol coordinate
+ * @param c Coordinate (less than SOBOL_COORDS)
+ * @param directions Array for 32 direction numbers
+ */
+static void sobol_directions(unsigned short c, uint32_t directions[32]){
+    if(c == 0){
+        for(int j = 0; j < 32; j++){
+            directions[j] = (uint32_t)1 << (31 - j);
+        }
+        return;
+    }
+    const TSobolPoly *p = &(SOBOL_POLYS[c - 1]);
+    for(int j = 0; j < 32; j++){
+        if(j < p->degree){
+            directions[j] = (uint32_t)p->m[j] << (31 - j);
+            continue;
+        }
+        directions[j] = directions[j - p->degree] ^ (directions[j - p->degree] >> p->degree);
+        for(int k = 1; k < p->degree; k++){
+            if((p->poly >> (p->degree - 1 - k)) & 1){
+                directions[j] ^= directions[j - k];
+            }
+        }
+    }
+}
+
+/**
+ * Computes the next prime (base of Halton coordinate)
+ * @param n Previous prime (or 1)
+ * @return The smallest prime bigger than n
+ */
+static unsigned int next_prime(unsigned int n){
+    while(true){
+        n++;
+        bool prime = true;
+        for(unsigned int d = 2; d * d <= n && prime; d++){
+            prime = n % d != 0;
+        }
+        if(prime){
+            return n;
+        }
+    }
+}
+
+/**
+ * Permutes index in range using key (Kensler's hash based permutation)
+ * Hash is bijection on the next power of 2, values outside the range are hashed again
+ * @param index Index (less than n)
+ * @param n Size of the range
+ * @param key Key choosing permutation
+ * @return Permuted index
+ */
+static unsigned int permute_index(unsigned int index, unsigned int n, uint32_t key){
+    uint32_t mask = n - 1;
+    mask |= mask >> 1;
+    mask |= mask >> 2;
+    mask |= mask >> 4;
+    mask |= mask >> 8;
+    mask |= mask >> 16;
+    uint32_t i = index;
+    do{
+        i ^= key;
+        i *= 0xe170893d;
+        i ^= key >> 16;
+        i ^= (i & mask) >> 4;
+        i ^= key >> 8;
+        i *= 0x0929eb3f;
+        i ^= key >> 23;
+        i ^= (i & mask) >> 1;
+        i *= 1 | key >> 27;
+        i *= 0x6935fa69;
+        i ^= (i & mask) >> 11;
+        i *= 0x74dcb303;
+        i ^= (i & mask) >> 2;
+        i *= 0x9e501cc3;
+        i ^= (i & mask) >> 2;
+        i *= 0xc860a3df;
+        i &= mask;
+        i ^= i >> 5;
+    } while(i >= n);
+    return i;
+}
+
+/**
+ * Initializes range of particles of SoA swarm
+ * Positions are points of the whole swarm given by their index, so that every
+ * worker can initialize its own range. Point sets are randomized by the key
+ * (random shift of Halton, digital shift of Sobol and permutations of Latin hypercube).
+ * @param s Swarm to be initialized
+ * @param bounds Function bounds
+ * @param begin Index of the 1st particle to be initialized
+ * @param end Index after the last particle to be initialized
+ * @param init How the positions are generated
+ * @param key Key randomizing point set (the same for all workers of a run)
+ * @param rng Pseudo-random generator to be used
  */
-#define random_double(min, max) (double)((double)(min) + (rand()/(RAND_MAX/((double)(max)-(double)(min)))))
+static void init_swarm_soa(TSwarmSoA *s, double bounds[][2], unsigned int begin, unsigned int end, TPSOInit init, uint64_t key, TPSORng *rng){
+    unsigned int base = 1;
+    for(unsigned short c = 0; c < s->coords; c++){
+        double *velocity = &(s->velocity[c*s->stride]);
+        double *position = &(s->position[c*s->stride]);
+        double *best_pos = &(s->best_pos[c*s->stride]);
+        double range = bounds[c][1] - bounds[c][0];
+        uint64_t ckey = splitmix64(key + c);
+        uint32_t directions[32];
+        TPSOInit cinit = init == PSO_INIT_SOBOL && c >= SOBOL_COORDS ? PSO_INIT_LATIN : init;
+        if(cinit == PSO_INIT_SOBOL){
+            sobol_directions(c, directions);
+        }
+        else if(cinit == PSO_INIT_HALTON){
+            base = next_prime(base);
+        }
+        // Random velocity from -1 to 1 and position from minimal
+        //  possible to maximal and set best position to current
+        for(unsigned int a = begin; a < end; a++){
+            velocity[a] = rng_double(rng, -1, 1);
+            double u;
+            if(cinit == PSO_INIT_SOBOL){
+                uint32_t x = (uint32_t)(ckey >> 32);
+                for(unsigned int i = a, j = 0; i; i >>= 1, j++){
+                    x ^= (i & 1) ? directions[j] : 0;
+                }
+                u = x * 0x1.0p-32;
+            }
+            else if(cinit == PSO_INIT_HALTON){
+                // Radical inverse of index + 1 (index 0 would be 0 in all coordinates)
+                u = (ckey >> 11) * 0x1.0p-53;
+                double digit = 1.0 / base;
+                for(unsigned int i = a + 1; i; i /= base, digit /= base){
+                    u += (i % base) * digit;
+                }
+                u -= u >= 1.0 ? 1.0 : 0.0;
+            }
+            else if(cinit == PSO_INIT_LATIN){
+                // Every particle gets its own stratum, position within it is random
+                u = (permute_index(a, s->particle_am, (uint32_t)ckey) + rng_double(rng, 0, 1)) / s->particle_am;
+            }
+            else{
+                u = rng_double(rng, 0, 1);
+            }
+            best_pos[a] = position[a] = bounds[c][0] + u * range;
+        }
+    }
+}
+
+/**
+ * Chooses random neighbors of range of particles
+ * @param s Swarm
+ * @param begin Index of the 1st particle
+ * @param end Index after the last particle
+ * @param rng Pseudo-random generator to be used
+ */
+static void init_links(TSwarmSoA *s, unsigned int begin, unsigned int end, TPSORng *rng){
+    for(size_t k = (size_t)begin * s->links_am; k < (size_t)end * s->links_am; k++){
+        s->links[k] = rng_next(rng) % s->particle_am;
+    }
+}
+
+/**
+ * Places range of particles for the start of a run
+ * Particles are scattered over the bounds or, with `carry_over`, they keep positions and
+ * velocities from the previous run. Particles with start point from configuration are then
+ * moved to it (with Gaussian jitter).
+ * Personal bests are always set to the new positions, as function may have changed.
+ * @param run Swarm run
+ * @param begin Index of the 1st particle
+ * @param end Index after the last particle
+ * @param rng Pseudo-random generator to be used
+ */
+static void start_particles(TPSOOptimizer *run, unsigned int begin, unsigned int end, TPSORng *rng){
+    TSwarmSoA *s = &(run->swarm);
+    const TPSOConfig *config = &(run->config);
+    double (*bounds)[2] = run->bounds;
+    if(!run->filled || !config->carry_over){
+        init_swarm_soa(s, bounds, begin, end, config->init, run->init_key, rng);
+    }
+    else{
+        // Bounds could have changed too, so kept positions are clamped into them
+        for(unsigned short c = 0; c < s->coords; c++){
+            double *position = &(s->position[c*s->stride]);
+            double *best_pos = &(s->best_pos[c*s->stride]);
+            for(unsigned int a = begin; a < end; a++){
+                double x = position[a] > bounds[c][0] ? position[a] : bounds[c][0];
+                best_pos[a] = position[a] = x < bounds[c][1] ? x : bounds[c][1];
+            }
+        }
+    }
+    unsigned int points = config->start_points ? config->start_am : 0;
+    for(unsigned int a = begin; a < end && a < points; a++){
+        for(unsigned short c = 0; c < s->coords; c++){
+            double x = config->start_points[(size_t)a * s->coords + c];
+            if(config->start_jitter > 0.0){
+                x += config->start_jitter * (bounds[c][1] - bounds[c][0]) * rng_gauss(rng);
+            }
+            x = x > bounds[c][0] ? x : bounds[c][0];
+            s->best_pos[c*s->stride + a] = s->position[c*s->stride + a] = x < bounds[c][1] ? x : bounds[c][1];
+        }
+    }
+}
+
+/**
+ * Update velocity and position of range of particles in SoA swarm
+ * @param s Swarm to be updated
+ * @param bounds Function bounds
+ * @param best_pos Global best position
+ * @param personal Rows of personal best positions of all particles (NULL if social attractor is used instead)
+ * @param social Rows of social attractors of all particles (NULL if global best position is used)
+ * @param vmax Velocity limit of each coordinate
+ * @param reinit If particles which crossed bounds get random position
+ * @param begin Index of the 1st particle to be updated
+ * @param end Index after the last particle to be updated
+ * @param lanes Pseudo-random generators to be used
+ * @param prm Coefficients for this iteration
+ */
+static void update_swarm_soa(TSwarmSoA *s, double bounds[][2], double *best_pos, const double *personal, const double *social, const double *vmax, bool reinit,
+                             unsigned int begin, unsigned int end, TRngLanes *lanes, TRowUpdate prm){
+    // Random coefficients are generated for whole range at once by vectorized
+    //  generator, so that there is no chain of dependent generator calls
+    rng_lanes_fill(lanes, s->rand_p + begin, end - begin);
+    rng_lanes_fill(lanes, s->rand_g + begin, end - begin);
+
+    // Whole row is updated for each coordinate, memory is accessed linearly
+    for(unsigned short c = 0; c < s->coords; c++){
+        // Canonical update has own random coefficients for each coordinate,
+        //  legacy one uses the same for all coordinates of a particle
+        if(personal && c > 0){
+            rng_lanes_fill(lanes, s->rand_p + begin, end - begin);
+            rng_lanes_fill(lanes, s->rand_g + begin, end - begin);
+        }
+        if(reinit){
+            rng_lanes_fill(lanes, s->rand_r + begin, end - begin);
+        }
+        prm.social = best_pos[c];
+        prm.min = bounds[c][0];
+        prm.max = bounds[c][1];
+        prm.vmax = vmax[c];
+        row_update(&(s->velocity[c*s->stride + begin]), &(s->position[c*s->stride + begin]), s->rand_p + begin, s->rand_g + begin,
+                   personal ? &(personal[c*s->stride + begin]) : NULL, social ? &(social[c*s->stride + begin]) : NULL,
+                   reinit ? s->rand_r + begin : NULL, end - begin, &prm);
+    }
+}
+
+#ifdef PSO_INSTRUMENT
+/**
+ * Counts particles of range which are on a bound after update
+ * @param s Swarm
+ * @param bounds Function bounds
+ * @param begin Index of the 1st particle
+ * @param end Index after the last particle
+ */
+static void count_clamp_hits(TSwarmSoA *s, double bounds[][2], unsigned int begin, unsigned int end){
+    for(unsigned short c = 0; c < s->coords; c++){
+        const double *position = &(s->position[c*s->stride]);
+        uint64_t hits = 0;
+        for(unsigned int a = begin; a < end; a++){
+            hits += position[a] == bounds[c][0] || position[a] == bounds[c][1];
+        }
+        pso_instrument_clamp(c, hits);
+    }
+}
+#endif // PSO_INSTRUMENT
+
+/**
+ * Quantizes coordinate for cache key
+ * @param cache Cache
+ * @param x Coordinate
+ * @return Key coordinate (negative zero is turned into zero, so that equal keys have equal bits)
+ */
+static inline double cache_quantize(const TEvalCache *cache, double x){
+    return (cache->scale > 0.0 ? nearbyint(x * cache->scale) : x) + 0.0;
+}
+
+/**
+ * Looks up position in cache
+ * @param cache Cache
+ * @param pos Coordinates of the position
+ * @param coords The amount of coordinates
+ * @param tag Hash of the key is saved here
+ * @param slot Entry with the key (if found) or entry for it (where it should be stored) is saved here
+ * @return true if the position was found
+ * @note Only few entries are probed, when all are taken the home entry is replaced
+ */
+static bool cache_lookup(const TEvalCache *cache, const double *pos, unsigned short coords, uint64_t *tag, size_t *slot){
+    uint64_t h = 0x9E3779B97F4A7C15ULL;
+    for(unsigned short c = 0; c < coords; c++){
+        double q = cache_quantize(cache, pos[c]);
+        uint64_t bits;
+        memcpy(&bits, &q, sizeof(bits));
+        h = splitmix64(h ^ bits);
+    }
+    h |= 1;  // 0 is reserved for empty entries
+    *tag = h;
+    size_t home = h & cache->mask;
+    *slot = home;
+    for(size_t probe = 0; probe < CACHE_PROBES && probe <= cache->mask; probe++){
+        size_t e = (home + probe) & cache->mask;
+        if(cache->tags[e] == 0){
+            *slot = e;
+            return false;
+        }
+        if(cache->tags[e] == h){
+            const double *key = &(cache->keys[e * coords]);
+            bool equal = true;
+            for(unsigned short c = 0; c < coords && equal; c++){
+                equal = key[c] == cache_quantize(cache, pos[c]);
+            }
+            if(equal){
+                *slot = e;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * Saves value into cache entry
+ * @param cache Cache
+ * @param slot Entry given by cache_lookup
+ * @param pos Coordinates of the position
+ * @param coords The amount of coordinates
+ * @param tag Hash of the key given by cache_lookup
+ * @param value Function value
+ */
+static void cache_store(TEvalCache *cache, size_t slot, const double *pos, unsigned short coords, uint64_t tag, double value){
+    double *key = &(cache->keys[slot * coords]);
+    for(unsigned short c = 0; c < coords; c++){
+        key[c] = cache_quantize(cache, pos[c]);
+    }
+    cache->tags[slot] = tag;
+    cache->values[slot] = value;
+}
+
+/**
+ * Evaluates one position by worker, using its cache if it has one
+ * @param w Worker
+ * @param ev Evaluator to be used (not batch one)
+ * @param pos Coordinates of the position
+ * @param coords The amount of coordinates
+ * @return Function value
+ * @note Only missed positions are counted as evaluations
+ */
+static double evaluate_one(TSwarmWorker *w, const TEvaluator *ev, double *pos, unsigned short coords){
+    uint64_t tag;
+    size_t slot;
+    bool cached = w->run->swarm.cache_am > 0;
+    if(cached && cache_lookup(&(w->cache), pos, coords, &tag, &slot)){
+        w->cache_hits++;
+        return w->cache.values[slot];
+    }
+    double value = ev->function3 ? ev->function3(pos[0], pos[1]) : ev->function(pos);
+    if(cached){
+        cache_store(&(w->cache), slot, pos, coords, tag, value);
+    }
+    w->evaluations++;
+    return value;
+}
+
+/**
+ * Evaluates range of particles in SoA swarm with cache in front of the function
+ * @param s Swarm to be evaluated
+ * @param ev Evaluator to be used (not batch one)
+ * @param w Worker whose range and cache are used
+ * @param skip Particles with constraint violation above this are not evaluated (their value is NAN)
+ */
+static void evaluate_cached(TSwarmSoA *s, const TEvaluator *ev, TSwarmWorker *w, double skip){
+    double *coord_buf = w->coord_buf;
+    for(unsigned int a = w->begin; a < w->end; a++){
+        if(s->constr_am > 0 && s->violation[a] > skip){
+            s->values[a] = NAN;
+            w->skipped++;
+            continue;
+        }
+        for(unsigned short c = 0; c < s->coords; c++){
+            coord_buf[c] = s->position[c*s->stride + a];
+        }
+        s->values[a] = evaluate_one(w, ev, coord_buf, s->coords);
+    }
+}
+
+/**
+ * Evaluates current positions of range of particles in SoA swarm
+ * @param s Swarm to be evaluated
+ * @param ev Evaluator to be used
+ * @param begin Index of the 1st particle to be evaluated
+ * @param end Index after the last particle to be evaluated
+ * @param coord_buf Buffer for coordinates of one particle
+ * @param skip Particles with constraint violation above this are not evaluated by per particle
+ *             functions (their value is NAN), batch function gets the whole range
+ * @return The amount of evaluated particles
+ * @note Results are saved into `values` array of the swarm
+ */
+static unsigned int evaluate_swarm_soa(TSwarmSoA *s, const TEvaluator *ev, unsigned int begin, unsigned int end, double *coord_buf, double skip){
+    if(ev->batch){
+        // Batch function gets only the range, rows keep their stride
+        ev->batch(s->position + begin, s->stride, s->coords, end - begin, s->values + begin, ev->data);
+        return end - begin;
+    }
+    unsigned int evaluated = 0;
+    bool constrained = s->constr_am > 0;
+    for(unsigned int a = begin; a < end; a++){
+        if(constrained && s->violation[a] > skip){
+            s->values[a] = NAN;
+            continue;
+        }
+        if(ev->function3){
+            // Both coordinates are read directly from their rows
+            s->values[a] = ev->function3(s->position[a], s->position[s->stride + a]);
+        }
+        else{
+            // Gather coordinates of current particle so that they can be passed to the function
+            for(unsigned short c = 0; c < s->coords; c++){
+                coord_buf[c] = s->position[c*s->stride + a];
+            }
+            s->values[a] = ev->function(coord_buf);
+        }
+        evaluated++;
+    }
+    return evaluated;
+}
+
+/**
+ * Computes constraint violations of current positions of range of particles
+ * Violation is sum of positive parts of inequality constraints and of absolute values
+ * of equality constraints over their tolerance, it is 0 for feasible positions.
+ * @param s Swarm
+ * @param config Configuration with constraints function
+ * @param begin Index of the 1st particle
+ * @param end Index after the last particle
+ */
+static void evaluate_constraints(TSwarmSoA *s, const TPSOConfig *config, unsigned int begin, unsigned int end){
+    config->constraints(s->position + begin, s->stride, s->coords, end - begin, s->constr + begin, config->constraints_data);
+    double *violation = s->violation;
+    for(unsigned int a = begin; a < end; a++){
+        violation[a] = 0.0;
+    }
+    // Constraints are summed row by row, so that the loops are vectorized
+    for(unsigned int k = 0; k < s->constr_am; k++){
+        const double *g = &(s->constr[k*s->stride]);
+        if(k < config->ineq_am){
+            for(unsigned int a = begin; a < end; a++){
+                violation[a] += g[a] > 0.0 ? g[a] : 0.0;
+            }
+        }
+        else{
+            for(unsigned int a = begin; a < end; a++){
+                double h = fabs(g[a]) - config->eq_tol;
+                violation[a] += h > 0.0 ? h : 0.0;
+            }
+        }
+    }
+}
+
+/**
+ * Compares 2 values
+ * @param mode Comparison to be used
+ * @param fitness Fitness function (used only by PSO_MODE_FITNESS)
+ * @param a 1st value
+ * @param b 2nd value
+ * @return true if 1st value is better than 2nd value
+ */
+static inline bool is_better(TPSOMode mode, fit_func fitness, double a, double b){
+    switch(mode){
+        case PSO_MODE_MINIMIZE:
+            return a < b;
+        case PSO_MODE_MAXIMIZE:
+            return a > b;
+        default:
+            return fitness(a, b);
+    }
+}
+
+/**
+ * Compares 2 values of constrained problem (feasibility rules of Deb)
+ * Feasible value is better than infeasible one, 2 infeasible values are
+ * compared by their violations and 2 feasible values as without constraints
+ * @param mode Comparison to be used
+ * @param fitness Fitness function (used only by PSO_MODE_FITNESS)
+ * @param a 1st value
+ * @param va Constraint violation of 1st value
+ * @param b 2nd value
+ * @param vb Constraint violation of 2nd value
+ * @return true if 1st value is better than 2nd value
+ */
+static inline bool is_better_constrained(TPSOMode mode, fit_func fitness, double a, double va, double b, double vb){
+    if(va > 0.0 || vb > 0.0){
+        return va < vb;
+    }
+    return is_better(mode, fitness, a, b);
+}
+
+/**
+ * Compares personal bests of 2 particles
+ * @param s Swarm
+ * @param mode Comparison to be used
+ * @param fitness Fitness function (used only by PSO_MODE_FITNESS)
+ * @param a Index of 1st particle
+ * @param b Index of 2nd particle
+ * @return true if personal best of 1st particle is better
+ */
+static inline bool is_better_best(const TSwarmSoA *s, TPSOMode mode, fit_func fitness, unsigned int a, unsigned int b){
+    if(s->constr_am > 0){
+        return is_better_constrained(mode, fitness, s->best_val[a], s->best_viol[a], s->best_val[b], s->best_viol[b]);
+    }
+    return is_better(mode, fitness, s->best_val[a], s->best_val[b]);
+}
+
+/**
+ * Resolves comparison used by a run
+ * Built-in fitness functions are recognized, so that also callers
+ * passing them instead of setting the mode get the fast path
+ * @param mode Mode from configuration
+ * @param fitness Fitness function passed to the run (can be NULL for built-in modes)
+ * @return Mode to be used
+ */
+static TPSOMode resolve_mode(TPSOMode mode, fit_func fitness){
+    if(mode != PSO_MODE_FITNESS){
+        return mode;
+    }
+    if(fitness == pso_less || fitness == NULL){
+        return PSO_MODE_MINIMIZE;
+    }
+    if(fitness == pso_greater){
+        return PSO_MODE_MAXIMIZE;
+    }
+    return PSO_MODE_FITNESS;
+}
+
+/**
+ * Waits until all workers of the run reach this point
+ * @param run Swarm run
+ */
+static inline void sync_workers(TPSOOptimizer *run){
+    if(run->threads > 1){
+        pthread_barrier_wait(&(run->barrier));
+    }
+}
+
+/**
+ * Computes minimum and maximum of each coordinate of range of particles
+ * @param s Swarm
+ * @param begin Index of the 1st particle
+ * @param end Index after the last particle
+ * @param extents Array for minimum and maximum of each coordinate
+ */
+static void swarm_extents(TSwarmSoA *s, unsigned int begin, unsigned int end, double *extents){
+    for(unsigned short c = 0; c < s->coords; c++){
+        const double *position = &(s->position[c*s->stride]);
+        double min = position[begin];
+        double max = position[begin];
+        for(unsigned int a = begin + 1; a < end; a++){
+            min = position[a] < min ? position[a] : min;
+            max = position[a] > max ? position[a] : max;
+        }
+        extents[2*c] = min;
+        extents[2*c + 1] = max;
+    }
+}
+
+/**
+ * Computes diameter of the swarm from extents of all workers
+ * Diagonal of bounding box of all particles is used as diameter,
+ * it is never smaller than the largest distance of two particles.
+ * @param run Swarm run
+ * @return Diameter of the swarm
+ */
+static double swarm_diameter(TPSOOptimizer *run){
+    double diameter = 0.0;
+    for(unsigned short c = 0; c < run->swarm.coords; c++){
+        double min = run->workers[0].extents[2*c];
+        double max = run->workers[0].extents[2*c + 1];
+        for(unsigned int t = 1; t < run->threads; t++){
+            const double *extents = run->workers[t].extents;
+            min = extents[2*c] < min ? extents[2*c] : min;
+            max = extents[2*c + 1] > max ? extents[2*c + 1] : max;
+        }
+        diameter += (max - min) * (max - min);
+    }
+    return sqrt(diameter);
+}
+
+/**
+ * Computes time in seconds elapsed since given time
+ * @param start Time (of CLOCK_MONOTONIC)
+ */
+static double seconds_since(const struct timespec *start){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)(now.tv_sec - start->tv_sec) + (double)(now.tv_nsec - start->tv_nsec) * 1e-9;
+}
+
+/**
+ * Checks stopping criteria shared by all engines (all except the amount of iterations)
+ * @param config Configuration of the run
+ * @param mode Resolved optimization mode
+ * @param fitness Fitness function
+ * @param best_value Global best value
+ * @param feasible If the global best position satisfies constraints
+ * @param improved Iteration in which the global best improved last time
+ * @param i Finished iteration
+ * @param start Time when the run started
+ * @param diameter Optimizer whose swarm diameter is checked (NULL if the engine does not check it)
+ * @param stop Reason is saved here if the run should stop
+ * @return true if the run should stop
+ */
+static bool stop_criteria(const TPSOConfig *config, TPSOMode mode, fit_func fitness, double best_value, bool feasible, unsigned long improved,
+                          unsigned long i, const struct timespec *start, TPSOOptimizer *diameter, TPSOStop *stop){
+    // Target is reached when it is not better than the best value (which has to be feasible)
+    if(config->use_target && feasible && !is_better(mode, fitness, config->target_value, best_value)){
+        *stop = PSO_STOP_TARGET;
+    }
+    else if(config->stagnation_iter > 0 && i - improved >= config->stagnation_iter){
+        *stop = PSO_STOP_STAGNATION;
+    }
+    else if(diameter && config->diameter_eps > 0.0 && swarm_diameter(diameter) < config->diameter_eps){
+        *stop = PSO_STOP_DIAMETER;
+    }
+    else if(config->time_limit > 0.0 && seconds_since(start) >= config->time_limit){
+        *stop = PSO_STOP_TIME;
+    }
+    else{
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Reduces best particles of all workers into global best
+ * Workers are checked in fixed order so that result is deterministic
+ * @param run Swarm run
+ * @param i Current iteration
+ * @param first If this is the 1st iteration (global best is set from the 1st worker)
+ */
+static void reduce_best(TPSOOptimizer *run, unsigned long i, bool first){
+    TSwarmSoA *s = &(run->swarm);
+    unsigned int best_index = s->particle_am;
+    double old_value = run->best_value;
+    double old_viol = run->best_viol;
+    if(first){
+        run->best_value = run->workers[0].best_value;
+        run->best_viol = run->workers[0].best_viol;
+        best_index = run->workers[0].best_index;
+    }
+    for(unsigned int t = first ? 1 : 0; t < run->threads; t++){
+        TSwarmWorker *w = &(run->workers[t]);
+        if(w->best_index < w->end && is_better_constrained(run->mode, run->fitness, w->best_value, w->best_viol, run->best_value, run->best_viol)){
+            run->best_value = w->best_value;
+            run->best_viol = w->best_viol;
+            best_index = w->best_index;
+        }
+    }
+    // Global best position is copied only once per iteration
+    if(best_index < s->particle_am){
+        for(unsigned short c = 0; c < s->coords; c++){
+            run->best_pos[c] = s->position[c*s->stride + best_index];
+        }
+        // Decreased violation is improvement too
+        if(first || old_viol != run->best_viol || fabs(old_value - run->best_value) > run->config.stagnation_tol){
+            run->improved = i;
+        }
+    }
+}
+
+/**
+ * Checks stopping criteria after iteration
+ * @param run Swarm run
+ * @param i Finished iteration
+ * @return true if the run should stop, reason is saved into the run
+ */
+static bool check_stop(TPSOOptimizer *run, unsigned long i){
+    if(i + 1 >= run->config.max_iter){
+        run->stop = PSO_STOP_MAX_ITER;
+        return true;
+    }
+    return stop_criteria(&(run->config), run->mode, run->fitness, run->best_value, run->best_viol == 0.0, run->improved,
+                         i, &(run->start), run, &(run->stop));
+}
+
+/**
+ * Computes velocity limit of each coordinate
+ * @param config Configuration of the run
+ * @param bounds Function bounds
+ * @param coords The amount of coordinates
+ * @param vmax Limits are saved here (INFINITY if velocity is not limited)
+ */
+static void velocity_limits(const TPSOConfig *config, double bounds[][2], unsigned short coords, double *vmax){
+    for(unsigned short c = 0; c < coords; c++){
+        if(config->vmax){
+            vmax[c] = config->vmax[c];
+        }
+        else if(config->vmax_fraction > 0.0){
+            vmax[c] = config->vmax_fraction * (bounds[c][1] - bounds[c][0]);
+        }
+        else{
+            vmax[c] = INFINITY;
+        }
+    }
+}
+
+/**
+ * Computes inertia coefficient for iteration
+ * @param config Configuration of the run
+ * @param i Iteration
+ * @return Inertia coefficient
+ */
+static double inertia_at(const TPSOConfig *config, unsigned long i){
+    if(config->w_schedule == PSO_SCHEDULE_LINEAR && config->max_iter > 1){
+        return config->coeff_w + (config->coeff_w_end - config->coeff_w) * ((double)i / (double)(config->max_iter - 1));
+    }
+    return config->coeff_w;
+}
+
+/**
+ * Computes constriction factor (Clerc and Kennedy)
+ * @param config Configuration
+ * @return Constriction factor for PSO_UPDATE_CONSTRICTION (when sum of
+ *         coefficients is above 4), otherwise 1
+ */
+static double constriction(const TPSOConfig *config){
+    double phi = config->coeff_cp + config->coeff_cg;
+    if(config->update != PSO_UPDATE_CONSTRICTION || phi <= 4.0){
+        return 1.0;
+    }
+    return 2.0 / fabs(2.0 - phi - sqrt(phi * phi - 4.0 * phi));
+}
+
+/**
+ * Sets personal bests of worker's particles from their 1st evaluation and finds worker's best particle
+ * Personal best positions are already set by initialization
+ * @param w Worker
+ */
+static void first_bests(TSwarmWorker *w){
+    TPSOOptimizer *run = w->run;
+    TSwarmSoA *s = &(run->swarm);
+    w->best_index = w->begin;
+    w->best_value = s->values[w->begin];
+    w->best_viol = 0.0;
+    if(s->constr_am > 0){
+        w->best_viol = s->violation[w->begin];
+        for(unsigned int a = w->begin; a < w->end; a++){
+            double value = s->values[a];
+            s->best_val[a] = value;
+            s->best_viol[a] = s->violation[a];
+            if(is_better_constrained(run->mode, run->fitness, value, s->violation[a], w->best_value, w->best_viol)){
+                w->best_value = value;
+                w->best_viol = s->violation[a];
+                w->best_index = a;
+            }
+        }
+        return;
+    }
+    for(unsigned int a = w->begin; a < w->end; a++){
+        double value = s->values[a];
+        s->best_val[a] = value;
+        if(is_better(run->mode, run->fitness, value, w->best_value)){
+            w->best_value = value;
+            w->best_index = a;
+        }
+    }
+}
+
+/**
+ * Updates personal bests of worker's particles and finds worker's best particle
+ * Global best is not changed by any worker until all workers are done with this phase
+ * @param w Worker
+ * @param mode Comparison (constant for every call, so that the loop is specialized)
+ * @param fitness Fitness function (used only by PSO_MODE_FITNESS)
+ */
+static inline void update_bests(TSwarmWorker *w, TPSOMode mode, fit_func fitness){
+    TPSOOptimizer *run = w->run;
+    TSwarmSoA *s = &(run->swarm);
+    w->best_index = w->end;
+    w->best_value = run->best_value;
+    for(unsigned int a = w->begin; a < w->end; a++){
+        double value = s->values[a];
+        // Check if this is new personal best value
+        if(is_better(mode, fitness, value, s->best_val[a])){
+            // Save the personal best position and value
+            s->best_val[a] = value;
+            for(unsigned short c = 0; c < s->coords; c++){
+                s->best_pos[c*s->stride + a] = s->position[c*s->stride + a];
+            }
+            // Now check if the value is better than best value known to this worker
+            if(is_better(mode, fitness, value, w->best_value)){
+                w->best_value = value;
+                w->best_index = a;
+            }
+        }
+    }
+}
+
+/**
+ * Updates personal bests of worker's particles of constrained problem and finds worker's best particle
+ * Values are compared by feasibility rules (see is_better_constrained)
+ * @param w Worker
+ */
+static void update_bests_constrained(TSwarmWorker *w){
+    TPSOOptimizer *run = w->run;
+    TSwarmSoA *s = &(run->swarm);
+    w->best_index = w->end;
+    w->best_value = run->best_value;
+    w->best_viol = run->best_viol;
+    for(unsigned int a = w->begin; a < w->end; a++){
+        double value = s->values[a];
+        double viol = s->violation[a];
+        if(is_better_constrained(run->mode, run->fitness, value, viol, s->best_val[a], s->best_viol[a])){
+            s->best_val[a] = value;
+            s->best_viol[a] = viol;
+            for(unsigned short c = 0; c < s->coords; c++){
+                s->best_pos[c*s->stride + a] = s->position[c*s->stride + a];
+            }
+            if(is_better_constrained(run->mode, run->fitness, value, viol, w->best_value, w->best_viol)){
+                w->best_value = value;
+                w->best_viol = viol;
+                w->best_index = a;
+            }
+        }
+    }
+}
+
+/**
+ * Finds the best particle in neighborhood of one particle (for local topologies)
+ * @param run Swarm run
+ * @param a Index of the particle
+ * @param mode Comparison (constant for every call, so that the loop is specialized)
+ * @param fitness Fitness function (used only by PSO_MODE_FITNESS)
+ * @return Index of the particle with the best personal best value in the neighborhood
+ */
+static inline unsigned int neighborhood_best(TPSOOptimizer *run, unsigned int a, TPSOMode mode, fit_func fitness){
+    TSwarmSoA *s = &(run->swarm);
+    unsigned int n = s->particle_am;
+    unsigned int span = run->span;
+    unsigned int best = a;
+    switch(run->config.topology){
+        case PSO_TOPOLOGY_RING:
+            // Particles up to span positions on both sides (swarm is a ring)
+            for(unsigned int j = 1; j <= span; j++){
+                unsigned int l = a >= j ? a - j : a + n - j;
+                unsigned int r = a + j < n ? a + j : a + j - n;
+                best = is_better_best(s, mode, fitness, l, best) ? l : best;
+                best = is_better_best(s, mode, fitness, r, best) ? r : best;
+            }
+            break;
+        case PSO_TOPOLOGY_VON_NEUMANN: {
+            // Left, right, upper and lower particle in grid with rows of span particles (grid is a torus)
+            unsigned int adj[4] = {a >= 1 ? a - 1 : n - 1, a + 1 < n ? a + 1 : 0,
+                                   a >= span ? a - span : a + n - span, a + span < n ? a + span : a + span - n};
+            for(int j = 0; j < 4; j++){
+                best = is_better_best(s, mode, fitness, adj[j], best) ? adj[j] : best;
+            }
+            break;
+        }
+        default: {
+            const unsigned int *links = &(s->links[(size_t)a * s->links_am]);
+            for(unsigned int j = 0; j < s->links_am; j++){
+                best = is_better_best(s, mode, fitness, links[j], best) ? links[j] : best;
+            }
+            break;
+        }
+    }
+    return best;
+}
+
+/**
+ * Finds the best particle in neighborhood of each of worker's particles
+ * Neighbors are near in the swarm (except for random topology), so their
+ * personal best values are read from the same or adjacent cache lines
+ * @param w Worker
+ * @param mode Comparison (constant for every call, so that the loop is specialized)
+ * @param fitness Fitness function (used only by PSO_MODE_FITNESS)
+ */
+static inline void find_neighborhood(TSwarmWorker *w, TPSOMode mode, fit_func fitness){
+    TPSOOptimizer *run = w->run;
+    TSwarmSoA *s = &(run->swarm);
+    for(unsigned int a = w->begin; a < w->end; a++){
+        s->nbest_index[a] = neighborhood_best(run, a, mode, fitness);
+    }
+    // Positions are gathered row by row, so that writes are linear
+    for(unsigned short c = 0; c < s->coords; c++){
+        const double *best_pos = &(s->best_pos[c*s->stride]);
+        double *nbest_pos = &(s->nbest_pos[c*s->stride]);
+        for(unsigned int a = w->begin; a < w->end; a++){
+            nbest_pos[a] = best_pos[s->nbest_index[a]];
+        }
+    }
+}
+
+/**
+ * Finds neighborhood bests of worker's particles (see find_neighborhood)
+ * @param w Worker
+ */
+static void neighborhood_bests(TSwarmWorker *w){
+    switch(w->run->mode){
+        case PSO_MODE_MINIMIZE:
+            find_neighborhood(w, PSO_MODE_MINIMIZE, NULL);
+            break;
+        case PSO_MODE_MAXIMIZE:
+            find_neighborhood(w, PSO_MODE_MAXIMIZE, NULL);
+            break;
+        default:
+            find_neighborhood(w, PSO_MODE_FITNESS, w->run->fitness);
+            break;
+    }
+}
+
+/**
+ * Publishes particle in mailbox
+ * @param mail Mailbox
+ * @param pos Coordinates of the particle
+ * @param value Value of the particle
+ * @param coords The amount of coordinates
+ */
+static void mail_write(TIslandMail *mail, const double *pos, double value, unsigned short coords){
+    unsigned long seq = atomic_load_explicit(&(mail->seq), memory_order_relaxed);
+    atomic_store_explicit(&(mail->seq), seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&(mail->value), value, memory_order_relaxed);
+    for(unsigned short c = 0; c < coords; c++){
+        atomic_store_explicit(&(mail->pos[c]), pos[c], memory_order_relaxed);
+    }
+    atomic_store_explicit(&(mail->seq), seq + 2, memory_order_release);
+}
+
+/**
+ * Reads particle from mailbox without waiting for its writer
+ * @param mail Mailbox
+ * @param pos Array for coordinates of the particle
+ * @param value Value of the particle is saved here
+ * @param coords The amount of coordinates
+ * @param seq Sequence of the read particle is saved here
+ * @return false if nothing was published or particle was being written during the read
+ */
+static bool mail_read(TIslandMail *mail, double *pos, double *value, unsigned short coords, unsigned long *seq){
+    unsigned long begin = atomic_load_explicit(&(mail->seq), memory_order_acquire);
+    if(begin == 0 || begin % 2 == 1){
+        return false;
+    }
+    *value = atomic_load_explicit(&(mail->value), memory_order_relaxed);
+    for(unsigned short c = 0; c < coords; c++){
+        pos[c] = atomic_load_explicit(&(mail->pos[c]), memory_order_relaxed);
+    }
+    atomic_thread_fence(memory_order_acquire);
+    *seq = begin;
+    return atomic_load_explicit(&(mail->seq), memory_order_relaxed) == begin;
+}
+
+/**
+ * Exchanges best particles with neighboring islands
+ * Island's best particle is published and particle from the previous island
+ * replaces the particle with the worst personal best, if it is better.
+ * Only feasible particles are published, so received particle is feasible.
+ * @param run Swarm run of the island (its only worker is between iterations)
+ * @param i Finished iteration
+ */
+static void island_migrate(TPSOOptimizer *run, unsigned long i){
+    TIsland *island = run->island;
+    TSwarmSoA *s = &(run->swarm);
+    if(run->config.migration_iter == 0 || (i + 1) % run->config.migration_iter != 0){
+        return;
+    }
+    if(run->best_viol == 0.0){
+        mail_write(island->outbox, run->best_pos, run->best_value, s->coords);
+    }
+
+    double *pos = run->workers[0].coord_buf;
+    double value;
+    unsigned long seq;
+    if(!mail_read(island->inbox, pos, &value, s->coords, &seq) || seq == island->seen){
+        return;
+    }
+    island->seen = seq;
+    unsigned int worst = 0;
+    for(unsigned int a = 1; a < s->particle_am; a++){
+        worst = is_better_best(s, run->mode, run->fitness, worst, a) ? a : worst;
+    }
+    double worst_viol = s->constr_am > 0 ? s->best_viol[worst] : 0.0;
+    if(!is_better_constrained(run->mode, run->fitness, value, 0.0, s->best_val[worst], worst_viol)){
+        return;
+    }
+    s->best_val[worst] = value;
+    if(s->constr_am > 0){
+        s->best_viol[worst] = 0.0;
+    }
+    for(unsigned short c = 0; c < s->coords; c++){
+        s->position[c*s->stride + worst] = pos[c];
+        s->best_pos[c*s->stride + worst] = pos[c];
+    }
+    if(is_better_constrained(run->mode, run->fitness, value, 0.0, run->best_value, run->best_viol)){
+        run->best_value = value;
+        run->best_viol = 0.0;
+        memcpy(run->best_pos, pos, sizeof(double) * s->coords);
+        run->improved = i;
+    }
+}
+
+/**
+ * Prepares parameters of velocity update which do not change between iterations
+ * @param config Configuration
+ * @return Parameters (inertia, social attractor and bounds have to be set for each update)
+ */
+static TRowUpdate update_params(const TPSOConfig *config){
+    // Constriction factor multiplies whole velocity, so it is folded into the coefficients
+    double chi = constriction(config);
+    TRowUpdate prm = {config->coeff_w, chi * config->coeff_cp, chi * config->coeff_cg, 0.0, 0.0, 0.0, INFINITY, false, 1.0};
+    // Velocity of particle which crossed bound is kept (clamp), zeroed (absorb, reinit) or reversed (reflect)
+    prm.reflect = config->boundary == PSO_BOUNDARY_REFLECT;
+    prm.bounce = config->boundary == PSO_BOUNDARY_CLAMP ? 1.0 : (config->boundary == PSO_BOUNDARY_REFLECT ? -1.0 : 0.0);
+    return prm;
+}
+
+/**
+ * Prepares asynchronous run
+ * All particles are initialized and queued for evaluation
+ * @param run Swarm run
+ */
+static void async_start(TPSOOptimizer *run){
+    TSwarmSoA *s = &(run->swarm);
+    TPSORng *rng = &(run->workers[0].rng);
+    start_particles(run, 0, s->particle_am, rng);
+    if(run->config.topology == PSO_TOPOLOGY_RANDOM){
+        init_links(s, 0, s->particle_am, rng);
+    }
+    for(unsigned int a = 0; a < s->particle_am; a++){
+        // Particles without personal best are never better than other particles
+        s->best_val[a] = NAN;
+        for(unsigned short c = 0; c < s->coords; c++){
+            s->pending[(size_t)a * s->coords + c] = s->position[c*s->stride + a];
+        }
+        s->ready[a] = a;
+    }
+    run->head = 0;
+    run->queued = s->particle_am;
+    run->in_flight = 0;
+    run->issued = 0;
+    run->completed = 0;
+}
+
+/**
+ * Takes the next particle for evaluation from queue of ready particles
+ * @param run Swarm run (has to be locked)
+ * @param particle Index of the particle is saved here
+ * @return false if no particle should be evaluated now
+ */
+static bool async_take(TPSOOptimizer *run, unsigned int *particle){
+    if(run->stopping || run->queued == 0){
+        return false;
+    }
+    if(run->issued >= run->config.max_iter * run->swarm.particle_am){
+        run->stopping = true;
+        run->stop = PSO_STOP_MAX_ITER;
+        return false;
+    }
+    *particle = run->swarm.ready[run->head];
+    run->head = run->head + 1 < run->swarm.particle_am ? run->head + 1 : 0;
+    run->queued--;
+    run->in_flight++;
+    run->issued++;
+    return true;
+}
+
+/**
+ * Checks if asynchronous run is finished
+ * @param run Swarm run (has to be locked)
+ * @return true if no particle is evaluated and no other will be
+ */
+static bool async_finished(TPSOOptimizer *run){
+    return run->in_flight == 0 && (run->stopping || run->queued == 0 ||
+                                   run->issued >= run->config.max_iter * run->swarm.particle_am);
+}
+
+/**
+ * Updates velocity and position of one particle of asynchronous run
+ * The same update as update_swarm_soa is done, neighborhood best is found only for this particle
+ * @param run Swarm run (has to be locked)
+ * @param a Index of the particle
+ * @param i The amount of finished iterations (evaluations of all particles)
+ */
+static void async_update(TPSOOptimizer *run, unsigned int a, unsigned long i){
+    TSwarmSoA *s = &(run->swarm);
+    const TPSOConfig *config = &(run->config);
+    // Generator of the 1st worker is shared by all threads under the lock
+    TPSORng *rng = &(run->workers[0].rng);
+    TRowUpdate prm = update_params(config);
+    prm.w = config->update == PSO_UPDATE_CONSTRICTION ? constriction(config) :
+            inertia_at(config, i < config->max_iter ? i : config->max_iter - 1);
+    const double *personal = config->update == PSO_UPDATE_LEGACY ? NULL : s->best_pos;
+    bool reinit = config->boundary == PSO_BOUNDARY_REINIT;
+    unsigned int best = config->topology == PSO_TOPOLOGY_GLOBAL ? s->particle_am : neighborhood_best(run, a, run->mode, run->fitness);
+    double rand_p = 0.0, rand_g = 0.0, rand_r = 0.0;
+    for(unsigned short c = 0; c < s->coords; c++){
+        size_t k = c*s->stride + a;
+        if(personal || c == 0){
+            rand_p = rng_double(rng, 0, 1);
+            rand_g = rng_double(rng, 0, 1);
+        }
+        if(reinit){
+            rand_r = rng_double(rng, 0, 1);
+        }
+        prm.social = best < s->particle_am ? s->best_pos[c*s->stride + best] : run->best_pos[c];
+        prm.min = run->bounds[c][0];
+        prm.max = run->bounds[c][1];
+        prm.vmax = run->vmax[c];
+        row_update(&(s->velocity[k]), &(s->position[k]), &rand_p, &rand_g, personal ? &(personal[k]) : NULL, NULL,
+                   reinit ? &rand_r : NULL, 1, &prm);
+        s->pending[(size_t)a * s->coords + c] = s->position[k];
+    }
+}
+
+/**
+ * Processes finished evaluation of asynchronous run
+ * Personal and global bests are updated, stopping criteria are checked
+ * and the particle is updated and queued for next evaluation
+ * @param run Swarm run (has to be locked)
+ * @param a Index of the evaluated particle
+ * @param value Function value of its submitted position
+ */
+static void async_complete(TPSOOptimizer *run, unsigned int a, double value){
+    TSwarmSoA *s = &(run->swarm);
+    const TPSOConfig *config = &(run->config);
+    INSTRUMENT_BEGIN(bests_ticks);
+    run->in_flight--;
+    run->completed++;
+    unsigned long i = run->completed / s->particle_am;
+    run->iterations = i;
+    s->values[a] = value;
+    // Completions come in any order, so the 1st value of particle is recognized by its missing personal best
+    if(isnan(s->best_val[a]) || is_better(run->mode, run->fitness, value, s->best_val[a])){
+        s->best_val[a] = value;
+        for(unsigned short c = 0; c < s->coords; c++){
+            s->best_pos[c*s->stride + a] = s->pending[(size_t)a * s->coords + c];
+        }
+        bool first = run->completed == 1;
+        if(first || is_better(run->mode, run->fitness, value, run->best_value)){
+            if(first || fabs(run->best_value - value) > config->stagnation_tol){
+                run->improved = i;
+            }
+            run->best_value = value;
+            for(unsigned short c = 0; c < s->coords; c++){
+                run->best_pos[c] = s->pending[(size_t)a * s->coords + c];
+            }
+        }
+    }
+    INSTRUMENT_END(PSO_PHASE_BESTS, bests_ticks);
+#ifdef PSO_INSTRUMENT
+    if(run->completed % s->particle_am == 0){
+        pso_instrument_iteration(i - 1, run->best_value, run->best_pos);
+    }
+#endif // PSO_INSTRUMENT
+    if(run->stopping){
+        return;
+    }
+    // Same criteria as check_stop, iterations are counted in evaluations of whole swarm
+    if(stop_criteria(config, run->mode, run->fitness, run->best_value, true, run->improved, i, &(run->start), NULL, &(run->stop))){
+        run->stopping = true;
+    }
+    else{
+        INSTRUMENT_BEGIN(update_ticks);
+        async_update(run, a, i);
+        INSTRUMENT_END(PSO_PHASE_UPDATE, update_ticks);
+#ifdef PSO_INSTRUMENT
+        for(unsigned short c = 0; c < s->coords; c++){
+            double x = s->position[c*s->stride + a];
+            pso_instrument_clamp(c, x == run->bounds[c][0] || x == run->bounds[c][1]);
+        }
+#endif // PSO_INSTRUMENT
+        unsigned int tail = run->head + run->queued;
+        s->ready[tail < s->particle_am ? tail : tail - s->particle_am] = a;
+        run->queued++;
+    }
+}
+
+/**
+ * Asynchronous PSO done by one worker
+ * Worker evaluates any ready particle, so no worker waits for slower evaluations of others
+ * @param w Worker
+ */
+static void async_worker(TSwarmWorker *w){
+    TPSOOptimizer *run = w->run;
+    TSwarmSoA *s = &(run->swarm);
+    pthread_mutex_lock(&(run->lock));
+    while(true){
+        unsigned int a;
+        if(async_take(run, &a)){
+            // Submitted position is not changed until its evaluation is completed
+            pthread_mutex_unlock(&(run->lock));
+            INSTRUMENT_BEGIN(evaluate_ticks);
+            double value = evaluate_one(w, run->ev, &(s->pending[(size_t)a * s->coords]), s->coords);
+            INSTRUMENT_END(PSO_PHASE_EVALUATE, evaluate_ticks);
+            pthread_mutex_lock(&(run->lock));
+            async_complete(run, a, value);
+            pthread_cond_signal(&(run->wake));
+        }
+        else if(async_finished(run)){
+            pthread_cond_broadcast(&(run->wake));
+            break;
+        }
+        else{
+            pthread_cond_wait(&(run->wake), &(run->lock));
+        }
+    }
+    pthread_mutex_unlock(&(run->lock));
+}
+
+/**
+ * Submits ready particles of asynchronous run to caller until the run is finished
+ * @param run Swarm run
+ */
+static void async_dispatch(TPSOOptimizer *run){
+    TSwarmSoA *s = &(run->swarm);
+    TSwarmWorker *w = run->workers;
+    pthread_mutex_lock(&(run->lock));
+    while(true){
+        unsigned int a;
+        if(async_take(run, &a)){
+            // Lock is not held, so submit function can complete the evaluation right away
+            pthread_mutex_unlock(&(run->lock));
+            run->ev->submit(a, &(s->pending[(size_t)a * s->coords]), run->ev->data);
+            w->evaluations++;
+            pthread_mutex_lock(&(run->lock));
+        }
+        else if(async_finished(run)){
+            break;
+        }
+        else{
+            pthread_cond_wait(&(run->wake), &(run->lock));
+        }
+    }
+    pthread_mutex_unlock(&(run->lock));
+}
+
+/**
+ * Saves state of synchronous run into checkpoint file
+ * File is written under temporary name and renamed, so that complete
+ * previous checkpoint is kept if writing fails.
+ * @param run Swarm run (between iterations)
+ * @param path Path of the file
+ * @return true if the checkpoint was written
+ */
+static bool write_checkpoint(TPSOOptimizer *run, const char *path){
+    TSwarmSoA *s = &(run->swarm);
+    size_t length = strlen(path);
+    char *temp = malloc(length + sizeof(".tmp"));
+#ifdef ASSERT_ALLOCATION
+    if(!temp){
+        error_handler();
+    }
+#endif // ASSERT_ALLOCATION
+    if(!temp){
+        return false;
+    }
+    memcpy(temp, path, length);
+    memcpy(temp + length, ".tmp", sizeof(".tmp"));
+    FILE *file = fopen(temp, "wb");
+    if(!file){
+        free(temp);
+        return false;
+    }
+    TCheckpointHeader header = {CHECKPOINT_MAGIC, CHECKPOINT_VERSION, s->coords, s->particle_am, run->threads, s->links_am, s->constr_am,
+                                s->stride, run->iterations, run->improved, run->best_value, run->best_viol, run->rng};
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = ok && fwrite(run->best_pos, sizeof(double), s->coords, file) == s->coords;
+    for(unsigned int t = 0; t < run->threads && ok; t++){
+        TSwarmWorker *w = &(run->workers[t]);
+        TCheckpointWorker state = {w->rng, w->lanes, w->evaluations, w->cache_hits, w->skipped};
+        ok = fwrite(&state, sizeof(state), 1, file) == 1;
+    }
+    // Rows of particles' state are next to each other in the arena, so they are written at once
+    size_t rows = s->stride * (3 * (size_t)s->coords + 1);
+    ok = ok && fwrite(s->velocity, sizeof(double), rows, file) == rows;
+    size_t links = s->stride * s->links_am;
+    ok = ok && (links == 0 || fwrite(s->links, sizeof(unsigned int), links, file) == links);
+    ok = ok && (s->constr_am == 0 || fwrite(s->best_viol, sizeof(double), s->stride, file) == s->stride);
+    ok = fclose(file) == 0 && ok;
+    ok = ok && rename(temp, path) == 0;
+    if(!ok){
+        remove(temp);
+    }
+    free(temp);
+    return ok;
+}
+
+/**
+ * Loads checkpoint file into optimizer, so that its next run continues the checkpointed one
+ * @param opt Optimizer
+ * @param path Path of the file
+ * @return false if the file cannot be read or it was written by optimizer with different
+ *         dimensions, particle amount, threads, topology links or constraints
+ */
+static bool read_checkpoint(TPSOOptimizer *opt, const char *path){
+    TSwarmSoA *s = &(opt->swarm);
+    opt->resume = false;
+    FILE *file = fopen(path, "rb");
+    if(!file){
+        return false;
+    }
+    TCheckpointHeader header;
+    bool ok = fread(&header, sizeof(header), 1, file) == 1 && header.magic == CHECKPOINT_MAGIC && header.version == CHECKPOINT_VERSION &&
+              header.coords == s->coords && header.particle_am == s->particle_am && header.threads == opt->threads &&
+              header.links_am == s->links_am && header.constr_am == s->constr_am && header.stride == s->stride;
+    ok = ok && fread(opt->best_pos, sizeof(double), s->coords, file) == s->coords;
+    for(unsigned int t = 0; t < opt->threads && ok; t++){
+        TSwarmWorker *w = &(opt->workers[t]);
+        TCheckpointWorker state;
+        ok = fread(&state, sizeof(state), 1, file) == 1;
+        w->rng = state.rng;
+        w->lanes = state.lanes;
+        w->evaluations = state.evaluations;
+        w->cache_hits = state.cache_hits;
+        w->skipped = state.skipped;
+    }
+    size_t rows = s->stride * (3 * (size_t)s->coords + 1);
+    ok = ok && fread(s->velocity, sizeof(double), rows, file) == rows;
+    size_t links = s->stride * s->links_am;
+    ok = ok && (links == 0 || fread(s->links, sizeof(unsigned int), links, file) == links);
+    ok = ok && (s->constr_am == 0 || fread(s->best_viol, sizeof(double), s->stride, file) == s->stride);
+    fclose(file);
+    // Swarm could be partially overwritten
+    opt->filled = opt->filled && ok;
+    if(ok){
+        opt->best_value = header.best_value;
+        opt->best_viol = header.best_viol;
+        opt->iterations = header.iterations;
+        opt->improved = header.improved;
+        opt->rng = header.rng;
+        opt->resume = true;
+    }
+    return ok;
+}
+
+/**
+ * Evaluates current positions of worker's particles
+ * Cache is in front of per particle functions only
+ * @param w Worker
+ */
+static void evaluate_worker(TSwarmWorker *w){
+    TPSOOptimizer *run = w->run;
+    TSwarmSoA *s = &(run->swarm);
+    double skip = run->config.skip_violation;
+    INSTRUMENT_BEGIN(evaluate_ticks);
+    // Constraints are evaluated for the same range just before the objective,
+    //   so that positions clearly out of feasible region are not evaluated
+    if(s->constr_am > 0){
+        evaluate_constraints(s, &(run->config), w->begin, w->end);
+    }
+    if(s->cache_am > 0 && !run->ev->batch){
+        evaluate_cached(s, run->ev, w, skip);
+    }
+    else{
+        unsigned int evaluated = evaluate_swarm_soa(s, run->ev, w->begin, w->end, w->coord_buf, skip);
+        w->evaluations += evaluated;
+        w->skipped += w->end - w->begin - evaluated;
+    }
+    INSTRUMENT_END(PSO_PHASE_EVALUATE, evaluate_ticks);
+}
+
+/**
+ * Finishes iteration after worker's bests were updated
+ * Global best is reduced, stopping criteria are checked and neighborhood bests are found
+ * @param w Worker
+ * @param i Current iteration
+ * @param first If this is the 1st iteration (there is no global best yet)
+ * @return true if the run should stop
+ */
+static bool end_iteration(TSwarmWorker *w, unsigned long i, bool first){
+    TPSOOptimizer *run = w->run;
+    const TPSOConfig *config = &(run->config);
+    if(config->diameter_eps > 0.0){
+        swarm_extents(&(run->swarm), w->begin, w->end, w->extents);
+    }
+    sync_workers(run);
+    INSTRUMENT_BEGIN(reduce_ticks);
+    if(w == run->workers){
+        reduce_best(run, i, first);
+        run->iterations = i + 1;
+        run->stopping = check_stop(run, i);
+        if(run->island && !run->stopping){
+            island_migrate(run, i);
+        }
+#ifdef PSO_INSTRUMENT
+        pso_instrument_iteration(i, run->best_value, run->best_pos);
+#endif // PSO_INSTRUMENT
+    }
+    // Neighborhoods are done between barriers, so that no personal best
+    //   is changed by other workers while they are read
+    if(config->topology != PSO_TOPOLOGY_GLOBAL){
+        neighborhood_bests(w);
+    }
+    INSTRUMENT_END(PSO_PHASE_BESTS, reduce_ticks);
+    sync_workers(run);
+    return run->stopping;
+}
+
+/**
+ * Updates velocity and position of worker's particles and writes checkpoint if it is due
+ * @param w Worker
+ * @param i Current iteration
+ */
+static void move_worker(TSwarmWorker *w, unsigned long i){
+    TPSOOptimizer *run = w->run;
+    TSwarmSoA *s = &(run->swarm);
+    const TPSOConfig *config = &(run->config);
+    const double *personal = config->update == PSO_UPDATE_LEGACY ? NULL : s->best_pos;
+    TRowUpdate prm = update_params(config);
+    INSTRUMENT_BEGIN(update_ticks);
+    prm.w = config->update == PSO_UPDATE_CONSTRICTION ? constriction(config) : inertia_at(config, i);
+    update_swarm_soa(s, run->bounds, run->best_pos, personal, config->topology == PSO_TOPOLOGY_GLOBAL ? NULL : s->nbest_pos,
+                     run->vmax, config->boundary == PSO_BOUNDARY_REINIT, w->begin, w->end, &(w->lanes), prm);
+    INSTRUMENT_END(PSO_PHASE_UPDATE, update_ticks);
+#ifdef PSO_INSTRUMENT
+    count_clamp_hits(s, run->bounds, w->begin, w->end);
+#endif // PSO_INSTRUMENT
+    // Checkpoint is written once all particles are updated and no worker
+    //   changes the swarm until it is written
+    if(config->checkpoint_path && config->checkpoint_iter > 0 && (i + 1) % config->checkpoint_iter == 0){
+        sync_workers(run);
+        if(w == run->workers){
+            run->checkpoints += write_checkpoint(run, config->checkpoint_path);
+        }
+        sync_workers(run);
+    }
+}
+
+/**
+ * PSO algorithm done by one worker on its range of particles
+ * The 1st iteration is peeled, so that every value in the main loop
+ * is compared only with the personal best
+ * @param w Worker
+ */
+static void run_worker(TSwarmWorker *w){
+    TPSOOptimizer *run = w->run;
+    TSwarmSoA *s = &(run->swarm);
+    const TPSOConfig *config = &(run->config);
+    if(run->async){
+        async_worker(w);
+        return;
+    }
+    // Iterations are changed by the 1st worker only after other workers read them
+    unsigned long i = run->resume ? run->iterations : 0;
+
+    // Resumed swarm is already loaded from checkpoint
+    if(!run->resume){
+        start_particles(run, w->begin, w->end, &(w->rng));
+        if(config->topology == PSO_TOPOLOGY_RANDOM){
+            init_links(s, w->begin, w->end, &(w->rng));
+        }
+        if(config->max_iter == 0){
+            return;
+        }
+        evaluate_worker(w);
+        INSTRUMENT_BEGIN(bests_ticks);
+        first_bests(w);
+        INSTRUMENT_END(PSO_PHASE_BESTS, bests_ticks);
+        if(end_iteration(w, 0, true)){
+            return;
+        }
+        move_worker(w, 0);
+        i = 1;
+    }
+    for(; i < config->max_iter; i++){
+        evaluate_worker(w);
+        INSTRUMENT_BEGIN(bests_ticks);
+        // Comparison is resolved once per iteration, so built-in modes
+        //   get their own loops without any indirect call
+        if(s->constr_am > 0){
+            update_bests_constrained(w);
+        }
+        else{
+            switch(run->mode){
+                case PSO_MODE_MINIMIZE:
+                    update_bests(w, PSO_MODE_MINIMIZE, NULL);
+                    break;
+                case PSO_MODE_MAXIMIZE:
+                    update_bests(w, PSO_MODE_MAXIMIZE, NULL);
+                    break;
+                default:
+                    update_bests(w, PSO_MODE_FITNESS, run->fitness);
+                    break;
+            }
+        }
+        INSTRUMENT_END(PSO_PHASE_BESTS, bests_ticks);
+        if(end_iteration(w, i, false)){
+            break;
+        }
+        move_worker(w, i);
+    }
+}
+
+/**
+ * Creates threads of workers 1 to threads - 1 (the 1st worker runs in calling thread)
+ * Created threads wait in the gate. When all of them are created, the gate stays
+ * closed, so that workers can be set up for them, and open_gate starts them.
+ * When some thread cannot be created, the created ones are cancelled and joined.
+ * @param gate Gate of the threads (initialized here)
+ * @param threads The amount of workers
+ * @param routine Thread function, it has to call pass_gate first
+ * @param workers Array of workers
+ * @param size Size of one worker in bytes
+ * @param offset Offset of pthread_t of the thread in worker
+ * @return threads if all threads were created, otherwise the amount of created threads + 1
+ */
+static unsigned int create_threads(TThreadGate *gate, unsigned int threads, void *(*routine)(void *), void *workers, size_t size, size_t offset){
+    pthread_mutex_init(&(gate->lock), NULL);
+    gate->cancel = false;
+    pthread_mutex_lock(&(gate->lock));
+    unsigned int t = 1;
+    while(t < threads){
+        char *w = (char *)workers + size * t;
+        if(pthread_create((pthread_t *)(w + offset), NULL, routine, w) != 0){
+            break;
+        }
+        t++;
+    }
+    if(t == threads){
+        return threads;
+    }
+#ifdef ASSERT_ALLOCATION
+    error_handler();
+#endif // ASSERT_ALLOCATION
+    gate->cancel = true;
+    pthread_mutex_unlock(&(gate->lock));
+    for(unsigned int k = 1; k < t; k++){
+        pthread_join(*(pthread_t *)((char *)workers + size * k + offset), NULL);
+    }
+    pthread_mutex_destroy(&(gate->lock));
+    return t;
+}
+
+/**
+ * Starts threads waiting in the gate (after create_threads created all of them)
+ * @param gate Gate of the threads
+ */
+static void open_gate(TThreadGate *gate){
+    pthread_mutex_unlock(&(gate->lock));
+}
+
+/**
+ * Waits until the gate is opened
+ * @param gate Gate of the thread
+ * @return false if the thread should end without starting
+ */
+static bool pass_gate(TThreadGate *gate){
+    pthread_mutex_lock(&(gate->lock));
+    bool cancel = gate->cancel;
+    pthread_mutex_unlock(&(gate->lock));
+    return !cancel;
+}
+
+/**
+ * Thread function for workers
+ * Worker waits until a run starts and finishes it together with other workers
+ * @param arg Worker (TSwarmWorker *)
+ */
+static void *worker_thread(void *arg){
+    TSwarmWorker *w = arg;
+    TPSOOptimizer *run = w->run;
+    if(!pass_gate(&(run->gate))){
+        return NULL;
+    }
+    while(true){
+        // Wait for start of a run
+        pthread_barrier_wait(&(run->barrier));
+        if(run->quit){
+            break;
+        }
+        run_worker(w);
+        // Signal that the run is done
+        pthread_barrier_wait(&(run->barrier));
+    }
+    return NULL;
+}
+
+/**
+ * Splits the swarm between at most given amount of workers
+ * Every worker gets whole alignment blocks of particles, so that
+ * no cache line of the swarm is written by 2 workers.
+ * Workers of asynchronous runs take any ready particle, so they are
+ * limited only by the amount of particles.
+ * @param config Configuration
+ * @param threads The maximum amount of workers
+ * @param chunk The amount of particles per worker is saved here
+ * @return The amount of workers
+ */
+static unsigned int split_workers(const TPSOConfig *config, unsigned int threads, size_t *chunk){
+    unsigned int particle_am = config->particle_am;
+    size_t block = config->async ? 1 : SOA_ROW_DOUBLES;
+    size_t blocks = (particle_am + block - 1) / block;
+    if(threads > blocks){
+        threads = blocks > 0 ? blocks : 1;
+    }
+    *chunk = (blocks + threads - 1) / threads * block;
+    threads = (particle_am + *chunk - 1) / *chunk;
+    return threads > 0 ? threads : 1;
+}
+
+/**
+ * Computes how many workers should be used (see split_workers)
+ * @param config Configuration
+ * @param chunk The amount of particles per worker is saved here
+ * @return The amount of workers
+ */
+static unsigned int plan_workers(const TPSOConfig *config, size_t *chunk){
+    unsigned int threads = config->threads;
+    if(threads == 0){
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = online > 0 ? (unsigned int)online : 1;
+    }
+    return split_workers(config, threads, chunk);
+}
+
+/**
+ * Stops worker threads of the optimizer and frees workers
+ * @param opt Optimizer
+ */
+static void stop_workers(TPSOOptimizer *opt){
+    if(opt->threads > 1){
+        opt->quit = true;
+        pthread_barrier_wait(&(opt->barrier));
+        for(unsigned int t = 1; t < opt->threads; t++){
+            pthread_join(opt->workers[t].thread, NULL);
+        }
+        pthread_barrier_destroy(&(opt->barrier));
+        pthread_mutex_destroy(&(opt->gate.lock));
+        if(!opt->region){
+            free(opt->workers);
+        }
+    }
+    opt->workers = NULL;
+    opt->threads = 0;
+}
+
+/**
+ * Creates workers for the optimizer and allocates swarm for them
+ * @param opt Optimizer
+ * @return true if everything was allocated and started
+ */
+static bool start_workers(TPSOOptimizer *opt){
+    size_t chunk;
+    unsigned int particle_am = opt->config.particle_am;
+    unsigned int threads = plan_workers(&(opt->config), &chunk);
+
+    size_t workers_size = threads > 1 ? sizeof(TSwarmWorker) * threads : 0;
+    TSwarmShape shape = {opt->coords, particle_am, threads, topology_links(&(opt->config)), cache_entries(&(opt->config)), constraint_count(&(opt->config))};
+    void *arena = opt->swarm.arena;
+    unsigned int previous = opt->filled ? opt->swarm.particle_am : 0;
+
+    if(opt->region){
+        // Workers and swarm are placed into caller buffer, which cannot grow
+        if(workers_size + soa_arena_size(&shape) > opt->region_size){
+            return false;
+        }
+        layout_swarm_soa(&(opt->swarm), (double *)((char *)opt->region + workers_size), &shape);
+        opt->capacity = particle_am;
+        opt->swarm_threads = threads;
+    }
+    else{
+        // Swarm is allocated again only when it is too small or
+        //  when there are buffers for different amount of threads
+        if(opt->swarm.arena && (opt->capacity < particle_am || threads != opt->swarm_threads ||
+                                opt->swarm_links < shape.links_am || opt->swarm_cache < shape.cache_am || opt->swarm_constr < shape.constr_am)){
+            free_swarm_soa(&(opt->swarm));
+        }
+        if(!opt->swarm.arena){
+            alloc_swarm_soa(&(opt->swarm), &shape);
+            if(!opt->swarm.arena){
+                return false;
+            }
+            opt->capacity = particle_am;
+            opt->swarm_threads = threads;
+            opt->swarm_links = shape.links_am;
+            opt->swarm_cache = shape.cache_am;
+            opt->swarm_constr = shape.constr_am;
+        }
+    }
+    // Particles of the previous run are kept only when swarm rows did not move
+    opt->filled = opt->filled && opt->swarm.arena == arena && previous == particle_am;
+    // Kept swarm can be bigger than needed
+    opt->swarm.particle_am = particle_am;
+    opt->swarm.links_am = shape.links_am;
+    opt->swarm.cache_am = shape.cache_am;
+    opt->swarm.constr_am = shape.constr_am;
+
+    // Single worker is part of the optimizer, more are allocated (or are at the start of the region)
+    opt->workers = &(opt->single);
+    if(threads > 1 && opt->region){
+        opt->workers = opt->region;
+    }
+    else if(threads > 1){
+        opt->workers = aligned_alloc(SOA_ALIGNMENT, sizeof(TSwarmWorker) * threads);
+#ifdef ASSERT_ALLOCATION
+        if(!opt->workers){
+            error_handler();
+        }
+#endif // ASSERT_ALLOCATION
+        if(!opt->workers){
+            return false;
+        }
+    }
+    if(threads > 1){
+        opt->quit = false;
+        for(unsigned int t = 0; t < threads; t++){
+            opt->workers[t].run = opt;
+        }
+        // When some thread cannot be created, swarm is split between the threads which could
+        unsigned int started;
+        while(threads > 1 && (started = create_threads(&(opt->gate), threads, worker_thread, opt->workers,
+                                                       sizeof(TSwarmWorker), offsetof(TSwarmWorker, thread))) < threads){
+            threads = split_workers(&(opt->config), started, &chunk);
+        }
+        if(threads == 1){
+            if(!opt->region){
+                free(opt->workers);
+            }
+            opt->workers = &(opt->single);
+        }
+    }
+    opt->threads = threads;
+    for(unsigned int t = 0; t < threads; t++){
+        TSwarmWorker *w = &(opt->workers[t]);
+        w->run = opt;
+        w->coord_buf = opt->swarm.coord_buf + soa_round_up(opt->coords) * t;
+        w->extents = opt->swarm.extents + 2 * soa_round_up(opt->coords) * t;
+        w->cache.mask = shape.cache_am > 0 ? shape.cache_am - 1 : 0;
+        w->cache.scale = opt->config.cache_tol > 0.0 ? 1.0 / opt->config.cache_tol : 0.0;
+        w->cache.tags = (uint64_t *)(opt->swarm.caches + (size_t)shape.cache_am * (opt->coords + 2) * t);
+        w->cache.values = (double *)(w->cache.tags + shape.cache_am);
+        w->cache.keys = w->cache.values + shape.cache_am;
+        w->begin = t * chunk;
+        w->end = (t + 1) * chunk < particle_am ? (t + 1) * chunk : particle_am;
+    }
+
+    if(threads > 1){
+        pthread_barrier_init(&(opt->barrier), NULL, threads);
+        open_gate(&(opt->gate));
+    }
+    return true;
+}
+
+/**
+ * Computes size of the optimizer together with its global best position and velocity limits
+ * @param coords How many coordinates particles have (dimensions - 1)
+ * @return Size in bytes (multiple of alignment)
+ */
+static size_t optimizer_size(unsigned short coords){
+    return (sizeof(TPSOOptimizer) + 2 * sizeof(double) * coords + SOA_ALIGNMENT - 1) / SOA_ALIGNMENT * SOA_ALIGNMENT;
+}
+
+/**
+ * Sets up optimizer in already allocated memory and starts its workers
+ * @param opt Optimizer (memory with size given by optimizer_size)
+ * @param coords How many coordinates particles have (dimensions - 1)
+ * @param config Configuration of the optimizer
+ * @param region Memory for workers and swarm (NULL if they should be allocated)
+ * @param region_size Size of the region in bytes
+ * @return true if workers were started
+ */
+static bool setup_optimizer(TPSOOptimizer *opt, unsigned short coords, const TPSOConfig *config, void *region, size_t region_size){
+    opt->config = *config;
+    opt->coords = coords;
+    opt->capacity = 0;
+    opt->swarm_threads = 0;
+    opt->swarm_links = 0;
+    opt->swarm_cache = 0;
+    opt->swarm_constr = 0;
+    opt->threads = 0;
+    opt->workers = NULL;
+    opt->swarm.arena = NULL;
+    opt->region = region;
+    opt->region_size = region_size;
+    opt->island = NULL;
+    opt->resume = false;
+    opt->filled = false;
+    opt->best_pos = (double *)(opt + 1);
+    opt->vmax = opt->best_pos + coords;
+    pso_rng_seed(&(opt->rng), config->use_seed ? config->seed : default_seed());
+    if(!start_workers(opt)){
+        return false;
+    }
+    pthread_mutex_init(&(opt->lock), NULL);
+    pthread_cond_init(&(opt->wake), NULL);
+    return true;
+}
+
+/**
+ * Creates optimizer for functions with given amount of coordinates
+ * @param coords How many coordinates particles have (dimensions - 1)
+ * @param config Configuration of the optimizer
+ * @return New optimizer or NULL if allocation failed
+ */
+static TPSOOptimizer *create_optimizer(unsigned short coords, const TPSOConfig *config){
+    // Global best position is allocated together with the optimizer
+    TPSOOptimizer *opt = aligned_alloc(SOA_ALIGNMENT, optimizer_size(coords));
+#ifdef ASSERT_ALLOCATION
+    if(!opt){
+        error_handler();
+    }
+#endif // ASSERT_ALLOCATION
+    if(!opt){
+        return NULL;
+    }
+    if(!setup_optimizer(opt, coords, config, NULL, 0)){
+        free_swarm_soa(&(opt->swarm));
+        free(opt);
+        return NULL;
+    }
+    return opt;
+}
+
+/**
+ * Creates optimizer with all its memory in caller buffer
+ * @param buffer Buffer (does not have to be aligned)
+ * @param size Size of the buffer in bytes
+ * @param coords How many coordinates particles have (dimensions - 1)
+ * @param config Configuration of the optimizer
+ * @return New optimizer or NULL if the buffer is too small
+ */
+static TPSOOptimizer *create_optimizer_in(void *buffer, size_t size, unsigned short coords, const TPSOConfig *config){
+    uintptr_t address = (uintptr_t)buffer;
+    size_t skip = (SOA_ALIGNMENT - address % SOA_ALIGNMENT) % SOA_ALIGNMENT;
+    if(size < skip + optimizer_size(coords)){
+        return NULL;
+    }
+    TPSOOptimizer *opt = (TPSOOptimizer *)((char *)buffer + skip);
+    size -= skip + optimizer_size(coords);
+    if(!setup_optimizer(opt, coords, config, (char *)opt + optimizer_size(coords), size)){
+        return NULL;
+    }
+    return opt;
+}
+
+/**
+ * Computes how far neighbors of particle are for ring and von Neumann topologies
+ * @param config Configuration
+ * @return Ring radius (at most half of the swarm) or width of von Neumann grid
+ */
+static unsigned int topology_span(const TPSOConfig *config){
+    unsigned int n = config->particle_am;
+    if(config->topology == PSO_TOPOLOGY_VON_NEUMANN){
+        unsigned int cols = (unsigned int)ceil(sqrt((double)n));
+        return cols < n ? cols : n - 1;
+    }
+    unsigned int radius = config->neighbors > 0 ? config->neighbors : 1;
+    return radius <= (n - 1) / 2 ? radius : (n - 1) / 2;
+}
+
+/**
+ * Does one run of the optimizer
+ * Particles are initialized again in already allocated swarm
+ * @param opt Optimizer
+ * @param ev Evaluator of particle positions
+ * @param bounds Function bounds
+ * @param fitness Fitness function
+ * @param result Result of the run is saved here (can be NULL), the best position is
+ *               copied into its best_pos if it is not NULL, otherwise best_pos is set
+ *               to the optimizer's storage
+ */
+static void run_optimizer(TPSOOptimizer *opt, const TEvaluator *ev, double bounds[][2], fit_func fitness, TPSOResult *result){
+    opt->ev = ev;
+    opt->bounds = bounds;
+    opt->fitness = fitness;
+    opt->mode = resolve_mode(opt->config.mode, fitness);
+    opt->span = topology_span(&(opt->config));
+    velocity_limits(&(opt->config), bounds, opt->coords, opt->vmax);
+    // Per particle functions can be evaluated asynchronously (unless there are constraints), submitted positions always are
+    opt->async = ev->submit || (opt->config.async && !ev->batch && !opt->config.constraints);
+    opt->swarm.constr_am = opt->async ? 0 : constraint_count(&(opt->config));
+    // Only synchronous runs are checkpointed, so only they are resumed
+    if(!opt->async && !opt->resume && opt->config.resume && opt->config.checkpoint_path){
+        read_checkpoint(opt, opt->config.checkpoint_path);
+    }
+    opt->resume = opt->resume && !opt->async;
+    if(!opt->resume){
+        opt->best_value = NAN;  // Global best value (set by the 1st evaluation)
+        // Runs without iterations return zeroed position (as fixed size optimizers do)
+        memset(opt->best_pos, 0, sizeof(double) * opt->coords);
+        opt->best_viol = 0.0;
+        opt->improved = 0;
+        opt->iterations = 0;
+    }
+    opt->stop = PSO_STOP_MAX_ITER;
+    opt->stopping = false;
+    opt->checkpoints = 0;
+    clock_gettime(CLOCK_MONOTONIC, &(opt->start));
+
+    // Every worker has its own non-overlapping random sequence
+    TPSORng rng;
+    if(!opt->resume){
+        pso_rng_seed(&rng, rng_next(&(opt->rng)));
+        // Uniform initialization does not use the key, so it keeps random sequences of earlier versions
+        opt->init_key = opt->config.init == PSO_INIT_UNIFORM ? 0 : rng_next(&(opt->rng));
+    }
+    for(unsigned int t = 0; t < opt->threads; t++){
+        TSwarmWorker *w = &(opt->workers[t]);
+        if(!opt->resume){
+            w->rng = rng;
+            pso_rng_jump(&rng);
+            rng_lanes_seed(&(w->lanes), &(w->rng));
+            w->evaluations = 0;
+            w->cache_hits = 0;
+            w->skipped = 0;
+        }
+        // Function can be different in every run, so cached values are dropped
+        if(opt->swarm.cache_am > 0){
+            memset(w->cache.tags, 0, sizeof(uint64_t) * opt->swarm.cache_am);
+        }
+    }
+
+    if(opt->async){
+        async_start(opt);
+    }
+    if(ev->submit){
+        // Caller evaluates the positions, worker threads are not needed
+        async_dispatch(opt);
+    }
+    else{
+        // Start other workers and run the 1st one in calling thread
+        if(opt->threads > 1){
+            pthread_barrier_wait(&(opt->barrier));
+        }
+        run_worker(opt->workers);
+        if(opt->threads > 1){
+            pthread_barrier_wait(&(opt->barrier));
+        }
+    }
+    opt->resume = false;
+    opt->filled = true;
+
+    if(result){
+        if(result->best_pos){
+            memcpy(result->best_pos, opt->best_pos, sizeof(double) * opt->coords);
+        }
+        else{
+            result->best_pos = opt->best_pos;
+        }
+        result->best_value = opt->best_value;
+        result->violation = opt->best_viol;
+        result->evaluations = 0;
+        result->cache_hits = 0;
+        result->skipped = 0;
+        for(unsigned int t = 0; t < opt->threads; t++){
+            result->evaluations += opt->workers[t].evaluations;
+            result->cache_hits += opt->workers[t].cache_hits;
+            result->skipped += opt->workers[t].skipped;
+        }
+        result->cache_misses = opt->swarm.cache_am > 0 && !ev->batch && !ev->submit ? result->evaluations : 0;
+        result->iterations = opt->iterations;
+        result->checkpoints = opt->checkpoints;
+        result->elapsed = seconds_since(&(opt->start));
+        result->stop = opt->stop;
+    }
+}
+
+/**
+ * Creates reusable optimizer
+ * @param dimensions The dimensions of optimized functions (amount of coordinates plus 1)
+ * @param config Configuration of the optimizer (see pso_config_default)
+ * @return New optimizer or NULL if allocation failed
+ */
+TPSOOptimizer *pso_create(unsigned short dimensions, const TPSOConfig *config){
+    return create_optimizer(dimensions - 1, config);
+}
+
+/**
+ * Computes size of buffer needed by pso_create_in
+ * @param dimensions The dimensions of optimized functions (amount of coordinates plus 1)
+ * @param config Configuration of the optimizer
+ * @return Size in bytes
+ */
+size_t pso_buffer_size(unsigned short dimensions, const TPSOConfig *config){
+    size_t chunk;
+    unsigned short coords = dimensions - 1;
+    unsigned int threads = plan_workers(config, &chunk);
+    size_t workers_size = threads > 1 ? sizeof(TSwarmWorker) * threads : 0;
+    TSwarmShape shape = {coords, config->particle_am, threads, topology_links(config), cache_entries(config), constraint_count(config)};
+    return SOA_ALIGNMENT - 1 + optimizer_size(coords) + workers_size + soa_arena_size(&shape);
+}
+
+/**
+ * Creates reusable optimizer in caller buffer
+ * Optimizer does not allocate any memory, buffer has to stay valid until pso_destroy is called
+ * @param buffer Buffer (no alignment is needed)
+ * @param size Size of the buffer in bytes (see pso_buffer_size and PSO_BUFFER_SIZE)
+ * @param dimensions The dimensions of optimized functions (amount of coordinates plus 1)
+ * @param config Configuration of the optimizer (see pso_config_default)
+ * @return New optimizer or NULL if the buffer is too small
+ * @note pso_reset fails if new configuration does not fit into the buffer
+ */
+TPSOOptimizer *pso_create_in(void *buffer, size_t size, unsigned short dimensions, const TPSOConfig *config){
+    return create_optimizer_in(buffer, size, dimensions - 1, config);
+}
+
+/**
+ * Resets optimizer
+ * @param opt Optimizer
+ * @param config New configuration or NULL to keep the current one
+ * @return false if allocation failed (optimizer then cannot be used until successful reset)
+ */
+bool pso_reset(TPSOOptimizer *opt, const TPSOConfig *config){
+    if(config){
+        // Swarm is kept if it is big enough, only workers are created again
+        opt->config = *config;
+        opt->resume = false;
+        stop_workers(opt);
+        if(!start_workers(opt)){
+            return false;
+        }
+    }
+    if(!opt->workers){
+        return false;
+    }
+    pso_rng_seed(&(opt->rng), opt->config.use_seed ? opt->config.seed : default_seed());
+    return true;
+}
+
+/**
+ * Loads checkpoint written by optimizer (see `checkpoint_path` in TPSOConfig)
+ * The next synchronous run of the optimizer continues the checkpointed run from
+ * the iteration after the checkpoint, no position is evaluated again.
+ * It has to be run with the same function, bounds and configuration. Evaluations and
+ * iterations in its result include those done before the checkpoint.
+ * @param opt Optimizer
+ * @param path Path of the checkpoint file
+ * @return false if the file cannot be read or it was written by optimizer with
+ *         different dimensions, particle amount, threads or topology
+ */
+bool pso_resume(TPSOOptimizer *opt, const char *path){
+    return read_checkpoint(opt, path);
+}
+
+/**
+ * Runs optimization using reusable optimizer
+ * With `async` set in configuration, every thread takes the next updated particle
+ * as soon as it finished its evaluation (see pso_run_submit)
+ * @param opt Optimizer
+ * @param function Function in which is optimization done
+ * @param bounds Bounds of the function in which will be the function optimized
+ *               (n arrays of minimum and maximum)
+ * @param fitness Fitness functions that determinates if passed in value is better
+ *                than other passed in value
+ * @param result Result of the optimization is saved here (can be NULL), if its `best_pos` is not NULL,
+ *               the best position is copied into it, otherwise it is set to optimizer's storage,
+ *               which is valid until next run or destruction of the optimizer
+ */
+void pso_run(TPSOOptimizer *opt, funcndim function, double bounds[][2], fit_func fitness, TPSOResult *result){
+    TEvaluator ev = {function, NULL, NULL};
+    run_optimizer(opt, &ev, bounds, fitness, result);
+}
+
+/**
+ * Runs optimization with batch function using reusable optimizer
+ * @param opt Optimizer
+ * @param function Batch function in which is optimization done
+ * @param data Data passed to every call of the function (can be NULL)
+ * @param bounds Bounds of the function in which will be the function optimized
+ *               (n arrays of minimum and maximum)
+ * @param fitness Fitness functions that determinates if passed in value is better
+ *                than other passed in value
+ * @param result Result of the optimization is saved here (can be NULL), if its `best_pos` is not NULL,
+ *               the best position is copied into it, otherwise it is set to optimizer's storage,
+ *               which is valid until next run or destruction of the optimizer
+ */
+void pso_run_batch(TPSOOptimizer *opt, funcndim_batch function, void *data, double bounds[][2], fit_func fitness, TPSOResult *result){
+    TEvaluator ev = {NULL, function, data};
+    run_optimizer(opt, &ev, bounds, fitness, result);
+}
+
+/**
+ * Runs asynchronous optimization with evaluations done by caller
+ * Positions are passed to `submit` and caller passes their values to pso_complete
+ * (from any thread and in any order). Each particle is updated as soon as its own
+ * value is known using the best position known at that time and it is submitted
+ * again. This keeps all evaluators busy when evaluation time varies.
+ * The run does max_iter evaluations for every particle on average, then waits for
+ * all submitted evaluations and returns. Diameter stopping criterion is not used.
+ * @param opt Optimizer
+ * @param submit Function submitting position for evaluation, it is always called
+ *               from the calling thread and it can call pso_complete itself
+ * @param data Data passed to every call of submit (can be NULL)
+ * @param bounds Bounds of the function in which will be the function optimized
+ *               (n arrays of minimum and maximum)
+ * @param fitness Fitness functions that determinates if passed in value is better
+ *                than other passed in value
+ * @param result Result of the optimization is saved here (can be NULL), see pso_run
+ */
+void pso_run_submit(TPSOOptimizer *opt, submit_func submit, void *data, double bounds[][2], fit_func fitness, TPSOResult *result){
+    TEvaluator ev = {NULL, NULL, data, NULL, submit};
+    run_optimizer(opt, &ev, bounds, fitness, result);
+}
+
+/**
+ * Passes value of submitted position to asynchronous run (see pso_run_submit)
+ * @param opt Optimizer
+ * @param particle Index of the particle passed to submit function
+ * @param value Function value at the submitted position
+ */
+void pso_complete(TPSOOptimizer *opt, unsigned int particle, double value){
+    pthread_mutex_lock(&(opt->lock));
+    async_complete(opt, particle, value);
+    pthread_cond_signal(&(opt->wake));
+    pthread_mutex_unlock(&(opt->lock));
+}
+
+/**
+ * Destroys lock and condition variable of optimizer whose threads are stopped
+ * @param opt Optimizer
+ */
+static void release_optimizer(TPSOOptimizer *opt){
+    pthread_mutex_destroy(&(opt->lock));
+    pthread_cond_destroy(&(opt->wake));
+}
+
+/**
+ * Destroys optimizer, stops its threads and frees its memory
+ * @param opt Optimizer
+ */
+void pso_destroy(TPSOOptimizer *opt){
+    if(!opt){
+        return;
+    }
+    stop_workers(opt);
+    release_optimizer(opt);
+    // Optimizer in caller buffer does not own any memory
+    if(!opt->region){
+        free_swarm_soa(&(opt->swarm));
+        free(opt);
+    }
+}
+
+/**
+ * Runs PSO algorithm on SoA swarm once
+ * @param ev Evaluator of particle positions
+ * @param bounds Function bounds
+ * @param coords How many coordinates particles have (dimensions - 1)
+ * @param fitness Fitness function
+ * @param config Configuration of the run
+ * @param result Result of the run is saved here (can be NULL), its best_pos is used if it is not NULL
+ * @return Array with coords doubles - the best found coordinates.
+ */
+static double *run_swarm_soa(const TEvaluator *ev, double bounds[][2], unsigned short coords, fit_func fitness, const TPSOConfig *config, TPSOResult *result){
+    TPSOResult local = {NULL};
+    if(!result){
+        result = &local;
+    }
+    // Global best position is written into caller storage if there is any
+    double *best_pos = result->best_pos;
+    if(!best_pos){
+        best_pos = malloc(sizeof(double) * coords);
+#ifdef ASSERT_ALLOCATION
+        if(!best_pos){
+            error_handler();
+        }
+#endif // ASSERT_ALLOCATION
+        if(!best_pos){
+            return NULL;
+        }
+    }
+    TPSOOptimizer *opt = create_optimizer(coords, config);
+    if(!opt){
+        if(best_pos != result->best_pos){
+            free(best_pos);
+        }
+        return NULL;
+    }
+    result->best_pos = best_pos;
+    run_optimizer(opt, ev, bounds, fitness, result);
+    pso_destroy(opt);
+    return best_pos;
+}
+
+/**
+ * Pins calling thread to one of processors it is allowed to run on
+ * @param index Index of the thread (processors are assigned in round robin)
+ */
+static void pin_thread(unsigned int index){
+#ifdef __linux__
+    cpu_set_t allowed;
+    if(sched_getaffinity(0, sizeof(allowed), &allowed) != 0 || CPU_COUNT(&allowed) == 0){
+        return;
+    }
+    int skip = index % CPU_COUNT(&allowed);
+    for(int cpu = 0; cpu < CPU_SETSIZE; cpu++){
+        if(CPU_ISSET(cpu, &allowed) && skip-- == 0){
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+            break;
+        }
+    }
+#else
+    (void)index;
+#endif // __linux__
+}
+
+/**
+ * Thread function for islands
+ * @param arg Island (TIsland *)
+ */
+static void *island_thread(void *arg){
+    TIsland *island = arg;
+    // Island is pinned before its memory is allocated and first touched
+    if(island->config.pin_islands){
+        pin_thread(island->index);
+    }
+    island->opt = create_optimizer(island->coords, &(island->config));
+    if(island->opt){
+        island->opt->island = island;
+        island->result.best_pos = NULL;
+        run_optimizer(island->opt, island->ev, island->bounds, island->fitness, &(island->result));
+    }
+    return NULL;
+}
+
+/**
+ * Runs island model (see psondim_islands)
+ * @param ev Evaluator of particle positions
+ * @param bounds Function bounds
+ * @param coords How many coordinates particles have (dimensions - 1)
+ * @param fitness Fitness function
+ * @param config Configuration
+ * @param result Result (can be NULL), best position is written into its best_pos if it is set
+ * @return Best position (allocated if result has no best_pos) or NULL if allocation failed
+ */
+static double *run_islands(const TEvaluator *ev, double bounds[][2], unsigned short coords, fit_func fitness, const TPSOConfig *config, TPSOResult *result){
+    TPSOResult local = {NULL};
+    if(!result){
+        result = &local;
+    }
+    unsigned int islands = config->islands;
+    if(islands == 0){
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        islands = online > 0 ? (unsigned int)online : 1;
+    }
+    // Every mailbox has its own cache lines
+    size_t mail_size = (sizeof(TIslandMail) + sizeof(_Atomic double) * coords + SOA_ALIGNMENT - 1) / SOA_ALIGNMENT * SOA_ALIGNMENT;
+    TIsland *island = aligned_alloc(SOA_ALIGNMENT, sizeof(TIsland) * islands);
+    char *mail = aligned_alloc(SOA_ALIGNMENT, mail_size * islands);
+    double *best_pos = result->best_pos ? result->best_pos : malloc(sizeof(double) * coords);
+#ifdef ASSERT_ALLOCATION
+    if(!island || !mail || !best_pos){
+        error_handler();
+    }
+#endif // ASSERT_ALLOCATION
+    if(!island || !mail || !best_pos){
+        free(island);
+        free(mail);
+        if(best_pos != result->best_pos){
+            free(best_pos);
+        }
+        return NULL;
+    }
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    TPSORng rng;
+    pso_rng_seed(&rng, config->use_seed ? config->seed : default_seed());
+    for(unsigned int k = 0; k < islands; k++){
+        TIslandMail *box = (TIslandMail *)(mail + mail_size * k);
+        atomic_init(&(box->seq), 0);
+        island[k].outbox = box;
+        island[k].inbox = (TIslandMail *)(mail + mail_size * (k > 0 ? k - 1 : islands - 1));
+        island[k].seen = 0;
+        island[k].index = k;
+        island[k].config = *config;
+        island[k].config.threads = 1;
+        island[k].config.async = false;
+        island[k].config.checkpoint_path = NULL;
+        island[k].config.resume = false;
+        island[k].config.seed = pso_rng_next(&rng);
+        island[k].config.use_seed = true;
+        island[k].ev = ev;
+        island[k].bounds = bounds;
+        island[k].fitness = fitness;
+        island[k].coords = coords;
+        island[k].opt = NULL;
+    }
+    for(unsigned int k = 0; k < islands; k++){
+        int rc = pthread_create(&(island[k].thread), NULL, island_thread, &(island[k]));
+#ifdef ASSERT_ALLOCATION
+        if(rc != 0){
+            error_handler();
+        }
+#endif // ASSERT_ALLOCATION
+        if(rc != 0){
+            // Island runs in calling thread when thread cannot be created
+            island[k].thread = pthread_self();
+            island_thread(&(island[k]));
+        }
+    }
+    pthread_t self = pthread_self();
+    for(unsigned int k = 0; k < islands; k++){
+        if(!pthread_equal(island[k].thread, self)){
+            pthread_join(island[k].thread, NULL);
+        }
+    }
+
+    // Results of islands are combined in fixed order, so that result does not depend on timing of threads
+    TPSOMode mode = resolve_mode(config->mode, fitness);
+    TPSOResult *best = NULL;
+    bool failed = false;
+    result->evaluations = 0;
+    result->cache_hits = 0;
+    result->cache_misses = 0;
+    result->skipped = 0;
+    result->iterations = 0;
+    result->checkpoints = 0;
+    for(unsigned int k = 0; k < islands; k++){
+        if(!island[k].opt){
+            failed = true;
+            continue;
+        }
+        TPSOResult *r = &(island[k].result);
+        if(!best || is_better_constrained(mode, fitness, r->best_value, r->violation, best->best_value, best->violation)){
+            best = r;
+        }
+        result->evaluations += r->evaluations;
+        result->cache_hits += r->cache_hits;
+        result->cache_misses += r->cache_misses;
+        result->skipped += r->skipped;
+        result->iterations = r->iterations > result->iterations ? r->iterations : result->iterations;
+    }
+    if(!failed){
+        memcpy(best_pos, best->best_pos, sizeof(double) * coords);
+        result->best_pos = best_pos;
+        result->best_value = best->best_value;
+        result->violation = best->violation;
+        result->stop = best->stop;
+        result->elapsed = seconds_since(&start);
+    }
+    else if(best_pos != result->best_pos){
+        free(best_pos);
+    }
+    for(unsigned int k = 0; k < islands; k++){
+        pso_destroy(island[k].opt);
+    }
+    free(mail);
+    free(island);
+    return failed ? NULL : best_pos;
+}
+
+/**
+ * Computes size of memory block for single precision swarm
+ * @param coords Amount of coordinates
+ * @param particle_am Amount of particles
+ * @return Size in bytes (multiple of alignment)
+ */
+static size_t float_arena_size(unsigned short coords, unsigned int particle_am){
+    size_t stride = (particle_am + SOA_ROW_FLOATS - 1) / SOA_ROW_FLOATS * SOA_ROW_FLOATS;
+    // Velocity, position and best position rows for each coordinate and random numbers rows
+    //  are floats, best values and current values rows are doubles
+    return sizeof(float) * stride * (3 * (size_t)coords + 3) + sizeof(double) * stride * 2;
+}
+
+/**
+ * Places single precision swarm into aligned block of memory
+ * Float rows come first, rows have whole alignment blocks of floats, so that double rows stay aligned
+ * @param s Swarm to be placed
+ * @param arena Block of memory with size given by float_arena_size
+ * @param coords Amount of coordinates
+ * @param particle_am Amount of particles
+ */
+static void layout_swarm_float(TSwarmFloat *s, float *arena, unsigned short coords, unsigned int particle_am){
+    size_t stride = (particle_am + SOA_ROW_FLOATS - 1) / SOA_ROW_FLOATS * SOA_ROW_FLOATS;
+    s->arena = arena;
+    s->stride = stride;
+    s->particle_am = particle_am;
+    s->coords = coords;
+    s->velocity = arena;
+    s->position = s->velocity + stride * coords;
+    s->best_pos = s->position + stride * coords;
+    s->rand_p = s->best_pos + stride * coords;
+    s->rand_g = s->rand_p + stride;
+    s->rand_r = s->rand_g + stride;
+    s->best_val = (double *)(s->rand_r + stride);
+    s->values = s->best_val + stride;
+}
+
+/**
+ * Initializes range of particles of single precision swarm
+ * Positions are generated in double precision and rounded, so that
+ * they are the same as positions of double precision swarm rounded to floats
+ * @param s Swarm
+ * @param bounds Function bounds
+ * @param begin Index of the 1st particle
+ * @param end Index after the last particle
+ * @param rng Pseudo-random generator to be used
+ */
+static void init_swarm_float(TSwarmFloat *s, double bounds[][2], unsigned int begin, unsigned int end, TPSORng *rng){
+    for(unsigned short c = 0; c < s->coords; c++){
+        float *velocity = &(s->velocity[c*s->stride]);
+        float *position = &(s->position[c*s->stride]);
+        float *best_pos = &(s->best_pos[c*s->stride]);
+        for(unsigned int a = begin; a < end; a++){
+            velocity[a] = (float)rng_double(rng, -1, 1);
+            best_pos[a] = position[a] = (float)rng_double(rng, bounds[c][0], bounds[c][1]);
+        }
+    }
+}
+
+/**
+ * Updates velocity and position of range of particles of single precision swarm
+ * @param run Swarm run
+ * @param w Worker owning the range
+ * @param prm Coefficients for this iteration
+ */
+static void update_swarm_float(TFloatRun *run, TFloatWorker *w, TRowUpdate prm){
+    TSwarmFloat *s = &(run->swarm);
+    unsigned int begin = w->begin;
+    unsigned int end = w->end;
+    const float *personal = run->config->update == PSO_UPDATE_LEGACY ? NULL : s->best_pos;
+    bool reinit = run->config->boundary == PSO_BOUNDARY_REINIT;
+    rng_lanes_fill_float(&(w->lanes), s->rand_p + begin, end - begin);
+    rng_lanes_fill_float(&(w->lanes), s->rand_g + begin, end - begin);
+    for(unsigned short c = 0; c < s->coords; c++){
+        // Same as in update_swarm_soa
+        if(personal && c > 0){
+            rng_lanes_fill_float(&(w->lanes), s->rand_p + begin, end - begin);
+            rng_lanes_fill_float(&(w->lanes), s->rand_g + begin, end - begin);
+        }
+        if(reinit){
+            rng_lanes_fill_float(&(w->lanes), s->rand_r + begin, end - begin);
+        }
+        prm.social = run->best_pos[c];
+        prm.min = run->bounds[c][0];
+        prm.max = run->bounds[c][1];
+        prm.vmax = run->vmax[c];
+        row_update_float(&(s->velocity[c*s->stride + begin]), &(s->position[c*s->stride + begin]), s->rand_p + begin, s->rand_g + begin,
+                         personal ? &(personal[c*s->stride + begin]) : NULL, NULL, reinit ? s->rand_r + begin : NULL, end - begin, &prm);
+    }
+}
+
+/**
+ * Updates personal bests of worker's particles of single precision swarm and finds worker's best particle
+ * @param w Worker
+ * @param first If this is the 1st evaluation (personal bests are set without comparing)
+ * @param mode Comparison (constant for every call, so that the loop is specialized)
+ * @param fitness Fitness function (used only by PSO_MODE_FITNESS)
+ */
+static inline void float_bests(TFloatWorker *w, bool first, TPSOMode mode, fit_func fitness){
+    TFloatRun *run = w->run;
+    TSwarmFloat *s = &(run->swarm);
+    if(first){
+        w->best_index = w->begin;
+        w->best_value = s->values[w->begin];
+        for(unsigned int a = w->begin; a < w->end; a++){
+            double value = s->values[a];
+            s->best_val[a] = value;
+            if(is_better(mode, fitness, value, w->best_value)){
+                w->best_value = value;
+                w->best_index = a;
+            }
+        }
+        return;
+    }
+    w->best_index = w->end;
+    w->best_value = run->best_value;
+    for(unsigned int a = w->begin; a < w->end; a++){
+        double value = s->values[a];
+        if(is_better(mode, fitness, value, s->best_val[a])){
+            s->best_val[a] = value;
+            for(unsigned short c = 0; c < s->coords; c++){
+                s->best_pos[c*s->stride + a] = s->position[c*s->stride + a];
+            }
+            if(is_better(mode, fitness, value, w->best_value)){
+                w->best_value = value;
+                w->best_index = a;
+            }
+        }
+    }
+}
+
+/**
+ * Evaluates worker's particles of single precision swarm and updates their bests
+ * @param w Worker
+ * @param first If this is the 1st evaluation
+ */
+static void evaluate_float(TFloatWorker *w, bool first){
+    TFloatRun *run = w->run;
+    TSwarmFloat *s = &(run->swarm);
+    INSTRUMENT_BEGIN(evaluate_ticks);
+    run->function(s->position + w->begin, s->stride, s->coords, w->end - w->begin, s->values + w->begin, run->data);
+    w->evaluations += w->end - w->begin;
+    INSTRUMENT_END(PSO_PHASE_EVALUATE, evaluate_ticks);
+    INSTRUMENT_BEGIN(bests_ticks);
+    switch(run->mode){
+        case PSO_MODE_MINIMIZE:
+            float_bests(w, first, PSO_MODE_MINIMIZE, NULL);
+            break;
+        case PSO_MODE_MAXIMIZE:
+            float_bests(w, first, PSO_MODE_MAXIMIZE, NULL);
+            break;
+        default:
+            float_bests(w, first, PSO_MODE_FITNESS, run->fitness);
+            break;
+    }
+    INSTRUMENT_END(PSO_PHASE_BESTS, bests_ticks);
+}
+
+/**
+ * Reduces best particles of all workers of single precision swarm into global best and checks stopping criteria
+ * It is done by the 1st worker while other workers wait
+ * @param run Swarm run
+ * @param i Finished iteration
+ * @param first If this is the 1st iteration
+ */
+static void end_iteration_float(TFloatRun *run, unsigned long i, bool first){
+    TSwarmFloat *s = &(run->swarm);
+    const TPSOConfig *config = run->config;
+    unsigned int best_index = s->particle_am;
+    double old_value = run->best_value;
+    if(first){
+        run->best_value = run->workers[0].best_value;
+        best_index = run->workers[0].best_index;
+    }
+    for(unsigned int t = first ? 1 : 0; t < run->threads; t++){
+        TFloatWorker *w = &(run->workers[t]);
+        if(w->best_index < w->end && is_better(run->mode, run->fitness, w->best_value, run->best_value)){
+            run->best_value = w->best_value;
+            best_index = w->best_index;
+        }
+    }
+    if(best_index < s->particle_am){
+        for(unsigned short c = 0; c < s->coords; c++){
+            run->best_pos[c] = s->position[c*s->stride + best_index];
+        }
+        if(first || fabs(old_value - run->best_value) > config->stagnation_tol){
+            run->improved = i;
+        }
+    }
+    run->iterations = i + 1;
+    run->stop = PSO_STOP_MAX_ITER;
+    run->stopping = i + 1 >= config->max_iter ||
+                    stop_criteria(config, run->mode, run->fitness, run->best_value, true, run->improved, i, &(run->start), NULL, &(run->stop));
+#ifdef PSO_INSTRUMENT
+    pso_instrument_iteration(i, run->best_value, run->best_pos);
+#endif // PSO_INSTRUMENT
+}
+
+/**
+ * PSO algorithm done by one worker on its range of particles of single precision swarm
+ * @param w Worker
+ */
+static void run_worker_float(TFloatWorker *w){
+    TFloatRun *run = w->run;
+    const TPSOConfig *config = run->config;
+    init_swarm_float(&(run->swarm), run->bounds, w->begin, w->end, &(w->rng));
+    if(config->max_iter == 0){
+        return;
+    }
+    TRowUpdate prm = update_params(config);
+    for(unsigned long i = 0; i < config->max_iter; i++){
+        evaluate_float(w, i == 0);
+        if(run->threads > 1){
+            pthread_barrier_wait(&(run->barrier));
+        }
+        if(w == run->workers){
+            end_iteration_float(run, i, i == 0);
+        }
+        if(run->threads > 1){
+            pthread_barrier_wait(&(run->barrier));
+        }
+        if(run->stopping){
+            break;
+        }
+        INSTRUMENT_BEGIN(update_ticks);
+        prm.w = config->update == PSO_UPDATE_CONSTRICTION ? constriction(config) : inertia_at(config, i);
+        update_swarm_float(run, w, prm);
+        INSTRUMENT_END(PSO_PHASE_UPDATE, update_ticks);
+    }
+}
+
+/**
+ * Thread function for workers of single precision swarm
+ * @param arg Worker (TFloatWorker *)
+ */
+static void *float_thread(void *arg){
+    TFloatWorker *w = arg;
+    if(pass_gate(&(w->run->gate))){
+        run_worker_float(w);
+    }
+    return NULL;
+}
+
+/**
+ * Rounds the amount of particles per worker to whole cache lines of float rows
+ * @param particle_am Amount of particles
+ * @param chunk The amount of particles per worker (see split_workers), it is rounded
+ * @return The amount of workers
+ */
+static unsigned int float_workers(unsigned int particle_am, size_t *chunk){
+    *chunk = (*chunk + SOA_ROW_FLOATS - 1) / SOA_ROW_FLOATS * SOA_ROW_FLOATS;
+    unsigned int threads = (particle_am + *chunk - 1) / *chunk;
+    return threads > 0 ? threads : 1;
+}
+
+/**
+ * Does optimization with single precision swarm
+ * Workers and swarm exist only for this call
+ * @param function Batch function
+ * @param data Data passed to batch function
+ * @param bounds Function bounds
+ * @param coords How many coordinates particles have (dimensions - 1)
+ * @param fitness Fitness function
+ * @param config Configuration of the run
+ * @param result Result of the run is saved here (can be NULL), its best_pos is used if it is not NULL
+ * @return Array with coords doubles - the best found coordinates or NULL if allocation failed
+ */
+static double *run_swarm_float(funcndim_batch_float function, void *data, double bounds[][2], unsigned short coords, fit_func fitness,
+                               const TPSOConfig *config, TPSOResult *result){
+    TPSOResult local = {NULL};
+    if(!result){
+        result = &local;
+    }
+    // Workers get whole cache lines of float rows
+    size_t chunk;
+    plan_workers(config, &chunk);
+    unsigned int threads = float_workers(config->particle_am, &chunk);
+
+    TFloatRun run;
+    double *best_pos = result->best_pos ? result->best_pos : malloc(sizeof(double) * coords);
+    run.vmax = malloc(sizeof(double) * coords);
+    run.workers = aligned_alloc(SOA_ALIGNMENT, sizeof(TFloatWorker) * threads);
+    float *arena = aligned_alloc(SOA_ALIGNMENT, float_arena_size(coords, config->particle_am));
+#ifdef ASSERT_ALLOCATION
+    if(!best_pos || !run.vmax || !run.workers || !arena){
+        error_handler();
+    }
+#endif // ASSERT_ALLOCATION
+    if(!best_pos || !run.vmax || !run.workers || !arena){
+        if(best_pos != result->best_pos){
+            free(best_pos);
+        }
+        free(run.vmax);
+        free(run.workers);
+        free(arena);
+        return NULL;
+    }
+    layout_swarm_float(&(run.swarm), arena, coords, config->particle_am);
+    run.function = function;
+    run.data = data;
+    run.bounds = bounds;
+    run.fitness = fitness;
+    run.mode = resolve_mode(config->mode, fitness);
+    run.config = config;
+    run.best_pos = best_pos;
+    run.best_value = NAN;
+    run.improved = 0;
+    run.iterations = 0;
+    run.stop = PSO_STOP_MAX_ITER;
+    run.stopping = false;
+    memset(run.best_pos, 0, sizeof(double) * coords);
+    velocity_limits(config, bounds, coords, run.vmax);
+    clock_gettime(CLOCK_MONOTONIC, &(run.start));
+
+    // Workers are seeded the same way as workers of reusable optimizer
+    TPSORng seeder, rng;
+    pso_rng_seed(&seeder, config->use_seed ? config->seed : default_seed());
+    pso_rng_seed(&rng, rng_next(&seeder));
+    for(unsigned int t = 0; t < threads; t++){
+        run.workers[t].run = &run;
+    }
+    // When some thread cannot be created, swarm is split between the threads which could
+    unsigned int started;
+    while(threads > 1 && (started = create_threads(&(run.gate), threads, float_thread, run.workers,
+                                                   sizeof(TFloatWorker), offsetof(TFloatWorker, thread))) < threads){
+        split_workers(config, started, &chunk);
+        threads = float_workers(config->particle_am, &chunk);
+    }
+    run.threads = threads;
+    for(unsigned int t = 0; t < threads; t++){
+        TFloatWorker *w = &(run.workers[t]);
+        w->begin = t * chunk;
+        w->end = (t + 1) * chunk < config->particle_am ? (t + 1) * chunk : config->particle_am;
+        w->evaluations = 0;
+        w->rng = rng;
+        pso_rng_jump(&rng);
+        rng_lanes_seed(&(w->lanes), &(w->rng));
+    }
+    if(threads > 1){
+        pthread_barrier_init(&(run.barrier), NULL, threads);
+        open_gate(&(run.gate));
+    }
+    run_worker_float(run.workers);
+    if(threads > 1){
+        for(unsigned int t = 1; t < threads; t++){
+            pthread_join(run.workers[t].thread, NULL);
+        }
+        pthread_barrier_destroy(&(run.barrier));
+        pthread_mutex_destroy(&(run.gate.lock));
+    }
+
+    result->best_pos = best_pos;
+    result->best_value = run.best_value;
+    result->evaluations = 0;
+    for(unsigned int t = 0; t < threads; t++){
+        result->evaluations += run.workers[t].evaluations;
+    }
+    result->cache_hits = 0;
+    result->cache_misses = 0;
+    result->skipped = 0;
+    result->violation = 0.0;
+    result->iterations = run.iterations;
+    result->checkpoints = 0;
+    result->elapsed = seconds_since(&(run.start));
+    result->stop = run.stop;
+    free(arena);
+    free(run.workers);
+    free(run.vmax);
+    return best_pos;
+}
+
+/**
+ * Checks Pareto dominance of objective vectors (all objectives are minimized)
+ * @param a 1st vector
+ * @param a_step Distance of objectives of 1st vector
+ * @param b 2nd vector
+ * @param b_step Distance of objectives of 2nd vector
+ * @param m The amount of objectives
+ * @return 1 if a dominates b, -1 if b dominates a or they are equal, 0 otherwise
+ */
+static int pareto_compare(const double *a, size_t a_step, const double *b, size_t b_step, unsigned short m){
+    bool a_better = false;
+    bool b_better = false;
+    for(unsigned short k = 0; k < m; k++){
+        a_better = a_better || a[k*a_step] < b[k*b_step];
+        b_better = b_better || b[k*b_step] < a[k*a_step];
+    }
+    if(a_better){
+        return b_better ? 0 : 1;
+    }
+    return -1;
+}
+
+/**
+ * Computes grid cell of objective vector
+ * @param arch Archive with fitted grid
+ * @param obj Objective vector
+ * @param step Distance of objectives of the vector
+ * @return Cell key (never 0) or 0 if the vector is out of the grid
+ */
+static uint64_t archive_cell(const TParetoArchive *arch, const double *obj, size_t step){
+    uint64_t key = 0;
+    for(unsigned short k = 0; k < arch->objectives_am; k++){
+        uint64_t cell = 0;
+        double x = obj[k*step] - arch->grid_min[k];
+        if(x < 0.0 || x > arch->grid_step[k] * arch->divisions){
+            return 0;
+        }
+        if(arch->grid_step[k] > 0.0){
+            x /= arch->grid_step[k];
+            cell = x >= arch->divisions - 1 ? arch->divisions - 1 : (uint64_t)x;
+        }
+        key = splitmix64(key + cell);
+    }
+    return key ? key : 1;
+}
+
+/**
+ * Finds slot of grid cell in counting hash table
+ * @param arch Archive
+ * @param key Cell key
+ * @return Slot of the cell (it is used for the cell if it was empty)
+ */
+static unsigned int archive_slot(TParetoArchive *arch, uint64_t key){
+    unsigned int slot = (unsigned int)key & arch->mask;
+    while(arch->keys[slot] != 0 && arch->keys[slot] != key){
+        slot = (slot + 1) & arch->mask;
+    }
+    if(arch->keys[slot] == 0){
+        arch->keys[slot] = key;
+        arch->used++;
+    }
+    return slot;
+}
+
+/**
+ * Fits grid to members (and extra vector) and counts members in each cell
+ * @param arch Archive
+ * @param extra Objective vector which has to be in the grid too
+ */
+static void archive_grid(TParetoArchive *arch, const double *extra){
+    unsigned short m = arch->objectives_am;
+    for(unsigned short k = 0; k < m; k++){
+        double min = extra[k];
+        double max = min;
+        const double *row = &(arch->objectives[k*arch->row]);
+        for(unsigned int j = 0; j < arch->size; j++){
+            double x = row[j];
+            min = x < min ? x : min;
+            max = x > max ? x : max;
+        }
+        arch->grid_min[k] = min;
+        arch->grid_step[k] = (max - min) / arch->divisions;
+    }
+    memset(arch->keys, 0, sizeof(uint64_t) * (arch->mask + 1));
+    memset(arch->counts, 0, sizeof(unsigned int) * (arch->mask + 1));
+    arch->used = 0;
+    arch->crowded_valid = false;
+    for(unsigned int j = 0; j < arch->size; j++){
+        arch->slots[j] = archive_slot(arch, archive_cell(arch, &(arch->objectives[j]), arch->row));
+        arch->counts[arch->slots[j]]++;
+    }
+}
+
+/**
+ * Finds slot of grid cell of objective vector, the grid is fitted again if needed
+ * @param arch Archive
+ * @param obj Objective vector
+ * @return Slot of the cell in counting hash table
+ */
+static unsigned int archive_locate(TParetoArchive *arch, const double *obj){
+    uint64_t key = archive_cell(arch, obj, 1);
+    // Table is kept at most half full, so that probing stays short
+    if(key == 0 || arch->used > arch->capacity){
+        archive_grid(arch, obj);
+        key = archive_cell(arch, obj, 1);
+    }
+    return archive_slot(arch, key);
+}
+
+/**
+ * Removes member of archive
+ * The last member is moved into its place, so that members stay at the start of arrays
+ * @param arch Archive
+ * @param j Index of the member
+ */
+static void archive_remove(TParetoArchive *arch, unsigned int j){
+    unsigned int last = --arch->size;
+    arch->counts[arch->slots[j]]--;
+    arch->crowded_valid = arch->crowded_valid && arch->slots[j] != arch->crowded;
+    if(j != last){
+        for(unsigned short k = 0; k < arch->objectives_am; k++){
+            arch->objectives[k*arch->row + j] = arch->objectives[k*arch->row + last];
+        }
+        memcpy(&(arch->positions[(size_t)j*arch->coords]), &(arch->positions[(size_t)last*arch->coords]), sizeof(double) * arch->coords);
+        arch->slots[j] = arch->slots[last];
+    }
+}
+
+/**
+ * Inserts point into archive if it is not dominated by any member
+ * Members dominated by the point are removed. When the archive is full, member from
+ * the most crowded grid cell is replaced, unless the point itself is in such cell.
+ * @param arch Archive
+ * @param s Swarm
+ * @param obj Objective rows of the swarm
+ * @param a Index of particle whose current position is inserted
+ * @return true if the point was inserted
+ */
+static bool archive_insert(TParetoArchive *arch, const TSwarmSoA *s, const double *obj, unsigned int a){
+    unsigned short m = arch->objectives_am;
+    // Member which dominated previous point is likely to dominate this one too
+    if(arch->hint < arch->size && pareto_compare(&(obj[a]), s->stride, &(arch->objectives[arch->hint]), arch->row, m) < 0){
+        return false;
+    }
+    double *point = arch->point;
+    for(unsigned short k = 0; k < m; k++){
+        point[k] = obj[k*s->stride + a];
+    }
+    // Vectorized passes over objective rows, bit 0 is set if member is better in some
+    //   objective and bit 1 if the point is better in some objective
+    uint64_t *flags = arch->flags;
+    uint64_t all = ~(uint64_t)0;
+    memset(flags, 0, sizeof(uint64_t) * arch->size);
+    for(unsigned short k = 0; k < m; k++){
+        all = row_compare(&(arch->objectives[k*arch->row]), point[k], arch->size, flags);
+    }
+    // Point dominated by or equal to a member has flags 1 or 0, member dominated by the point has flags 2
+    if(!(all & 2)){
+        arch->hint = 0;
+        while(flags[arch->hint] & 2){
+            arch->hint++;
+        }
+        return false;
+    }
+    // Dominated members are removed from the end, so that moved members are already checked
+    for(unsigned int j = arch->size; !(all & 1) && j-- > 0;){
+        if(flags[j] == 2){
+            archive_remove(arch, j);
+        }
+    }
+    unsigned int slot = archive_locate(arch, point);
+    if(arch->size == arch->capacity){
+        if(!arch->crowded_valid){
+            arch->crowded = arch->slots[0];
+            for(unsigned int j = 1; j < arch->size; j++){
+                arch->crowded = arch->counts[arch->slots[j]] > arch->counts[arch->crowded] ? arch->slots[j] : arch->crowded;
+            }
+            arch->crowded_valid = true;
+        }
+        if(arch->counts[slot] + 1 >= arch->counts[arch->crowded]){
+            return false;
+        }
+        unsigned int worst = 0;
+        while(arch->slots[worst] != arch->crowded){
+            worst++;
+        }
+        archive_remove(arch, worst);
+    }
+    unsigned int j = arch->size++;
+    for(unsigned short k = 0; k < m; k++){
+        arch->objectives[k*arch->row + j] = point[k];
+    }
+    for(unsigned short c = 0; c < s->coords; c++){
+        arch->positions[(size_t)j*s->coords + c] = s->position[c*s->stride + a];
+    }
+    arch->slots[j] = slot;
+    arch->counts[slot]++;
+    arch->crowded_valid = arch->crowded_valid && arch->counts[slot] <= arch->counts[arch->crowded];
+    return true;
+}
+
+/**
+ * Updates personal bests of multi-objective swarm
+ * New position replaces personal best if it dominates it, when neither dominates
+ * the other one, one of them is chosen randomly
+ * @param s Swarm
+ * @param obj Objective rows of current positions
+ * @param best_obj Objective rows of personal best positions
+ * @param m The amount of objectives
+ * @param rng Pseudo-random generator
+ */
+static void multi_bests(TSwarmSoA *s, const double *obj, double *best_obj, unsigned short m, TPSORng *rng){
+    for(unsigned int a = 0; a < s->particle_am; a++){
+        int cmp = pareto_compare(&(obj[a]), s->stride, &(best_obj[a]), s->stride, m);
+        if(cmp > 0 || (cmp == 0 && (rng_next(rng) & 1))){
+            for(unsigned short k = 0; k < m; k++){
+                best_obj[k*s->stride + a] = obj[k*s->stride + a];
+            }
+            for(unsigned short c = 0; c < s->coords; c++){
+                s->best_pos[c*s->stride + a] = s->position[c*s->stride + a];
+            }
+        }
+    }
+}
 
 /**
- * 3 dimensional particle struct
+ * Chooses leader of each particle from archive
+ * Binary tournament prefers members from less crowded grid cells
+ * Coordinates of leaders are saved into neighborhood best rows
+ * @param arch Archive with counted grid cells
+ * @param s Swarm
+ * @param rng Pseudo-random generator
  */
-typedef struct {
-    double velocity[2];  //< Velocity for each dimension
-    double position[2];  //< Position in each dimension
-    double best_pos[2];  //< Best position
-    double best_val;     //< Value of the best position
-} TParticle3Dim;
+static void multi_leaders(const TParetoArchive *arch, TSwarmSoA *s, TPSORng *rng){
+    for(unsigned int a = 0; a < s->particle_am; a++){
+        unsigned int j = rng_next(rng) % arch->size;
+        unsigned int k = rng_next(rng) % arch->size;
+        j = arch->counts[arch->slots[k]] < arch->counts[arch->slots[j]] ? k : j;
+        for(unsigned short c = 0; c < s->coords; c++){
+            s->nbest_pos[c*s->stride + a] = arch->positions[(size_t)j*s->coords + c];
+        }
+    }
+}
 
 /**
- * Particle struct
+ * Multi-objective particle swarm optimization (MOPSO)
+ * @param function Batch function computing all objectives
+ * @param data Data passed to the function
+ * @param bounds Function bounds
+ * @param coords How many coordinates particles have (dimensions - 1)
+ * @param objectives The amount of objectives
+ * @param config Configuration
+ * @param front_pos Coordinates of found Pareto front are saved here (archive_size points)
+ * @param front_val Objective values of found Pareto front are saved here (archive_size vectors)
+ * @param result Statistics of the run are saved here (can be NULL)
+ * @return The amount of points of found Pareto front (0 if allocation failed)
+ * @note Capacity of the archive (archive_size) has to be at least 1
  */
-typedef struct {
-    double *velocity;  //< Velocity for each dimension
-    double *position;  //< Position in each dimension
-    double *best_pos;  //< Best position
-    double best_val;   //< Value of the best position
-} TParticle;
+static unsigned int run_multi(funcndim_multi function, void *data, double bounds[][2], unsigned short coords, unsigned short objectives,
+                              const TPSOConfig *config, double *front_pos, double *front_val, TPSOResult *result){
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    // Swarm has the same rows as swarm of the other engines, leaders are in neighborhood best rows
+    TSwarmShape shape = {coords, config->particle_am, 1, 0, 0, 0};
+    TSwarmSoA s;
+    alloc_swarm_soa(&s, &shape);
+    unsigned int capacity = config->archive_size;
+    unsigned int table = 1;
+    while(table < 2 * (capacity + 1)){
+        table <<= 1;
+    }
+    TParetoArchive arch = {NULL};
+    size_t rows = sizeof(double) * 2 * (size_t)objectives * s.stride;
+    size_t row = soa_round_up(capacity);
+    size_t archive = sizeof(double) * (row * objectives + (size_t)capacity * coords + 3 * (size_t)objectives + coords) +
+                     (sizeof(uint64_t) + sizeof(unsigned int)) * (size_t)table + (sizeof(uint64_t) + sizeof(unsigned int)) * (size_t)capacity;
+    double *block = s.arena ? aligned_alloc(SOA_ALIGNMENT, (rows + archive + SOA_ALIGNMENT - 1) / SOA_ALIGNMENT * SOA_ALIGNMENT) : NULL;
+#ifdef ASSERT_ALLOCATION
+    if(!block){
+        error_handler();
+    }
+#endif // ASSERT_ALLOCATION
+    if(!block){
+        free_swarm_soa(&s);
+        return 0;
+    }
+    // Objective rows of current and personal best positions, then the archive and velocity limits
+    double *obj = block;
+    double *best_obj = obj + (size_t)objectives * s.stride;
+    arch.objectives = best_obj + (size_t)objectives * s.stride;
+    arch.positions = arch.objectives + row * objectives;
+    arch.grid_min = arch.positions + (size_t)capacity * coords;
+    arch.grid_step = arch.grid_min + objectives;
+    arch.point = arch.grid_step + objectives;
+    double *vmax = arch.point + objectives;
+    arch.keys = (uint64_t *)(vmax + coords);
+    arch.flags = arch.keys + table;
+    arch.counts = (unsigned int *)(arch.flags + capacity);
+    arch.slots = arch.counts + table;
+    arch.row = row;
+    arch.mask = table - 1;
+    // Negative cell width puts every point out of the grid, so the 1st insertion fits it
+    for(unsigned short k = 0; k < objectives; k++){
+        arch.grid_min[k] = 0.0;
+        arch.grid_step[k] = -1.0;
+    }
+    arch.used = 0;
+    arch.hint = 0;
+    arch.crowded = 0;
+    arch.crowded_valid = false;
+    arch.size = 0;
+    arch.capacity = capacity;
+    arch.divisions = config->grid_divisions > 0 ? config->grid_divisions : 1;
+    arch.objectives_am = objectives;
+    arch.coords = coords;
 
+    velocity_limits(config, bounds, coords, vmax);
+    // Generators are seeded the same way as the 1st worker of other engines
+    TPSORng seeder, rng;
+    TRngLanes lanes;
+    pso_rng_seed(&seeder, config->use_seed ? config->seed : default_seed());
+    pso_rng_seed(&rng, rng_next(&seeder));
+    uint64_t key = config->init == PSO_INIT_UNIFORM ? 0 : rng_next(&seeder);
+    rng_lanes_seed(&lanes, &rng);
+    init_swarm_soa(&s, bounds, 0, s.particle_am, config->init, key, &rng);
+
+    unsigned long evaluations = 0;
+    unsigned long i = 0;
+    TPSOStop stop = PSO_STOP_MAX_ITER;
+    const double *personal = config->update == PSO_UPDATE_LEGACY ? NULL : s.best_pos;
+    TRowUpdate prm = update_params(config);
+    for(; i < config->max_iter; i++){
+        if(i > 0){
+            // Leaders are chosen from the archive as it is after previous iteration
+            multi_leaders(&arch, &s, &rng);
+            prm.w = config->update == PSO_UPDATE_CONSTRICTION ? constriction(config) : inertia_at(config, i - 1);
+            update_swarm_soa(&s, bounds, s.coord_buf, personal, s.nbest_pos, vmax, config->boundary == PSO_BOUNDARY_REINIT,
+                             0, s.particle_am, &lanes, prm);
+        }
+        function(s.position, s.stride, coords, s.particle_am, obj, data);
+        evaluations += s.particle_am;
+        if(i == 0){
+            memcpy(best_obj, obj, sizeof(double) * objectives * s.stride);
+        }
+        else{
+            multi_bests(&s, obj, best_obj, objectives, &rng);
+        }
+        for(unsigned int a = 0; a < s.particle_am; a++){
+            archive_insert(&arch, &s, obj, a);
+        }
+        if(config->time_limit > 0.0 && seconds_since(&start) >= config->time_limit){
+            stop = i + 1 < config->max_iter ? PSO_STOP_TIME : PSO_STOP_MAX_ITER;
+            i++;
+            break;
+        }
+    }
+    for(unsigned int j = 0; j < arch.size; j++){
+        for(unsigned short k = 0; k < objectives; k++){
+            front_val[(size_t)j*objectives + k] = arch.objectives[k*row + j];
+        }
+    }
+    memcpy(front_pos, arch.positions, sizeof(double) * arch.size * coords);
+    if(result){
+        result->best_value = NAN;
+        result->violation = 0.0;
+        result->evaluations = evaluations;
+        result->cache_hits = 0;
+        result->cache_misses = 0;
+        result->skipped = 0;
+        result->iterations = i;
+        result->checkpoints = 0;
+        result->elapsed = seconds_since(&start);
+        result->stop = stop;
+    }
+    unsigned int size = arch.size;
+    free(block);
+    free_swarm_soa(&s);
+    return size;
+}
 
-#ifdef ASSERT_ALLOCATION
 /**
- * Error handler function
- * @note This function is weak and can be redifined elsewhere
+ * Batch function calling 3 dimensional batch function
+ * @param positions Positions of all particles
+ * @param stride Length of one coordinate row
+ * @param coords Amount of coordinates (always 2)
+ * @param amount Amount of particles
+ * @param values Array for function values
+ * @param data Adapter data (TBatch3dimAdapter)
  */
-_Noreturn void __attribute__((weak)) error_handler(){
-    exit(1);
+static void batch3dim_adapter(const double *positions, size_t stride, unsigned short coords, unsigned int amount, double *values, void *data){
+    (void)coords;
+    TBatch3dimAdapter *adapter = data;
+    adapter->function(positions, positions + stride, amount, values, adapter->data);
 }
-#endif //ASSERT_ALLOCATION
 
 /**
- * Initializer function for PSO module
- * @warning This function should be called only once before any other PSO function is called
- * @note This function calls srand function
+ * Sets configuration to default values
+ * Coefficients are set to values of COEFF_W, COEFF_CP and COEFF_CG macros,
+ * inertia is constant, global topology is used, optimization runs in 1 thread,
+ * is seeded as calls without explicit seed and always does all iterations.
+ * @param config Configuration to be set
  */
-void pso_init(){
-    // Initializing pseudo-random generator
-    srand(time(NULL));
+void pso_config_default(TPSOConfig *config){
+    config->coeff_w = COEFF_W;
+    config->coeff_w_end = COEFF_W;
+    config->w_schedule = PSO_SCHEDULE_CONSTANT;
+    config->coeff_cp = COEFF_CP;
+    config->coeff_cg = COEFF_CG;
+    config->particle_am = 20;
+    config->max_iter = 1000;
+    config->topology = PSO_TOPOLOGY_GLOBAL;
+    config->mode = PSO_MODE_FITNESS;
+    config->neighbors = 0;
+    config->update = PSO_UPDATE_CANONICAL;
+    config->vmax_fraction = 0.0;
+    config->vmax = NULL;
+    config->boundary = PSO_BOUNDARY_CLAMP;
+    config->cache_size = 0;
+    config->cache_tol = 0.0;
+    config->async = false;
+    config->init = PSO_INIT_UNIFORM;
+    config->start_points = NULL;
+    config->start_am = 0;
+    config->start_jitter = 0.0;
+    config->carry_over = false;
+    config->threads = 1;
+    config->seed = 0;
+    config->use_seed = false;
+    config->target_value = 0.0;
+    config->use_target = false;
+    config->stagnation_iter = 0;
+    config->stagnation_tol = 0.0;
+    config->diameter_eps = 0.0;
+    config->time_limit = 0.0;
+    config->islands = 0;
+    config->migration_iter = 20;
+    config->pin_islands = false;
+    config->checkpoint_path = NULL;
+    config->checkpoint_iter = 0;
+    config->resume = false;
+    config->constraints = NULL;
+    config->constraints_data = NULL;
+    config->ineq_am = 0;
+    config->eq_am = 0;
+    config->eq_tol = 1e-4;
+    config->skip_violation = INFINITY;
+    config->archive_size = 100;
+    config->grid_divisions = 30;
 }
 
 /**
- * Initializes starting attributes for a particle
- * @param p Particle to be initialized
- * @param bounds Function bounds
+ * Creates default configuration with particle amount and iteration cap
+ * @param particle_am The amount of particles
+ * @param max_iter The amount of iterations
+ * @return Configuration
  */
-static void init_particle3dim(TParticle3Dim *p, double bounds[2][2]){
-    // Set values for every dimension
-    // Random velocity from -1 to 1
-    p->velocity[0] = random_double(-1, 1);
-    p->velocity[1] = random_double(-1, 1);
-    // Random position from minimal possible to maximal and set best position to current
-    p->best_pos[0] = p->position[0] = random_double(bounds[0][0], bounds[0][1]);
-    p->best_pos[1] = p->position[1] = random_double(bounds[1][0], bounds[1][1]);
+static TPSOConfig default_config(unsigned int particle_am, unsigned long max_iter){
+    TPSOConfig config;
+    pso_config_default(&config);
+    config.particle_am = particle_am;
+    config.max_iter = max_iter;
+    return config;
 }
 
 /**
- * Update velocity and position of a particle based on best global best position found
- * @param p Particle to be updated
- * @param bounds Function bounds
- * @param best_pos Global best position
+ * Particle swarm optimization algorithm for n dimensional functions with configuration
+ * @param function Function in which is optimization done
+ * @param bounds Bounds of the function in which will be the function optimized.
+ *               this should be n arrays (where n is the amount of dimensions of
+ *               the optimized function) of 2 values where the 1st one is the
+ *               minimum and second one is the maximum. E.g.: for `x in <0, 5> &
+ *               y in <-10, 10>` the bounds should be `{{0.0, 5.0}, {-10.0, 10.0}}`.
+ * @param dimensions The dimensions of optimized function.
+ *                   Dimensions means how many coordinates are there in the optimized
+ *                   function. E.g.: z = x^2 + y is 3 dimensional - it has 2 variables
+ *                   plus the result (3 dimensions).
+ * @param fitness Fitness functions that determinates if passed in value is better
+ *                than other passed in value
+ * @param config Configuration of the optimization (see pso_config_default)
+ * @param result Result of the optimization is saved here (can be NULL), if its `best_pos` is not NULL,
+ *               the best position is written into it and no memory for it is allocated
+ * @return Array with n (n = dimensions - 1) doubles - the best found coordinates
+ *         (this is `result->best_pos` if it was passed in).
+ * @note When more than 1 thread is used, function has to be thread safe
  */
-static void update_particle3dim(TParticle3Dim *p, double bounds[2][2], double best_pos[2]){
-    // Random coefficient pre-multiplied by cognitive/social coefficient
-    double rp = random_double(0, 1) * COEFF_CP;
-    double rg = random_double(0, 1) * COEFF_CG;
+double* psondim_config(funcndim function, double bounds[][2], unsigned short dimensions, fit_func fitness, const TPSOConfig *config, TPSOResult *result){
+    TEvaluator ev = {function, NULL, NULL};
+    // Adjust dimensions (3 dimensions means only 2 coordinates)
+    return run_swarm_soa(&ev, bounds, dimensions - 1, fitness, config, result);
+}
 
-    // Calculate new velocity for both dimensions
-    // Calculating with non-dependent values first to not slow down processing pipeline
-    // Differences are pre-calculated to avoid calculating them twice
-    double pos_diff0 = best_pos[0] - p->position[0];
-    double pos_diff1 = best_pos[1] - p->position[1];
-    p->velocity[0] = COEFF_W * p->velocity[0] + rp * pos_diff0 + rg * pos_diff0;
-    p->velocity[1] = COEFF_W * p->velocity[1] + rp * pos_diff1 + rg * pos_diff1;
+/**
+ * Particle swarm optimization algorithm with island model
+ * Several independent swarms (islands) run in their own threads. Every `migration_iter`
+ * iterations each island publishes its best particle and the next island (islands form
+ * a ring) takes it instead of its worst particle, if it is better. Particles are passed
+ * through lock-free mailboxes, so islands never wait for each other and share no
+ * memory between migrations. Each island checks stopping criteria on its own.
+ * @param function Function in which is optimization done (has to be thread safe)
+ * @param bounds Bounds of the function in which will be the function optimized.
+ *               this should be n arrays (where n is the amount of dimensions of
+ *               the optimized function) of 2 values where the 1st one is the
+ *               minimum and second one is the maximum. E.g.: for `x in <0, 5> &
+ *               y in <-10, 10>` the bounds should be `{{0.0, 5.0}, {-10.0, 10.0}}`.
+ * @param dimensions The dimensions of optimized function.
+ *                   Dimensions means how many coordinates are there in the optimized
+ *                   function. E.g.: z = x^2 + y is 3 dimensional - it has 2 variables
+ *                   plus the result (3 dimensions).
+ * @param fitness Fitness functions that determinates if passed in value is better
+ *                than other passed in value
+ * @param config Configuration of every island (`threads` and `async` are not used) and
+ *               of the island model (see pso_config_default)
+ * @param result Result of the optimization is saved here (can be NULL), if its `best_pos` is not NULL,
+ *               the best position is written into it and no memory for it is allocated.
+ *               Result of the best island is used, evaluations are summed over all islands
+ *               and iterations is the most iterations done by an island.
+ * @return Array with n (n = dimensions - 1) doubles - the best found coordinates
+ *         (this is `result->best_pos` if it was passed in) or NULL if allocation failed.
+ */
+double* psondim_islands(funcndim function, double bounds[][2], unsigned short dimensions, fit_func fitness, const TPSOConfig *config, TPSOResult *result){
+    TEvaluator ev = {function, NULL, NULL};
+    return run_islands(&ev, bounds, dimensions - 1, fitness, config, result);
+}
 
-    // Calculate new position
-    // Adjust if new position is out of bounds
-    p->position[0] += p->velocity[0];
-    p->position[1] += p->velocity[1];
+/**
+ * Particle swarm optimization algorithm for n dimensional functions using batch evaluation with configuration
+ * @param function Batch function in which is optimization done, it is called
+ *                 once per iteration for the whole swarm (once per thread for its
+ *                 particles when more than 1 thread is used)
+ * @param data Data passed to every call of the function (can be NULL)
+ * @param bounds Bounds of the function in which will be the function optimized.
+ *               this should be n arrays (where n is the amount of dimensions of
+ *               the optimized function) of 2 values where the 1st one is the
+ *               minimum and second one is the maximum. E.g.: for `x in <0, 5> &
+ *               y in <-10, 10>` the bounds should be `{{0.0, 5.0}, {-10.0, 10.0}}`.
+ * @param dimensions The dimensions of optimized function.
+ *                   Dimensions means how many coordinates are there in the optimized
+ *                   function. E.g.: z = x^2 + y is 3 dimensional - it has 2 variables
+ *                   plus the result (3 dimensions).
+ * @param fitness Fitness functions that determinates if passed in value is better
+ *                than other passed in value
+ * @param config Configuration of the optimization (see pso_config_default)
+ * @param result Result of the optimization is saved here (can be NULL), if its `best_pos` is not NULL,
+ *               the best position is written into it and no memory for it is allocated
+ * @return Array with n (n = dimensions - 1) doubles - the best found coordinates
+ *         (this is `result->best_pos` if it was passed in).
+ */
+double* psondim_batch_config(funcndim_batch function, void *data, double bounds[][2], unsigned short dimensions, fit_func fitness, const TPSOConfig *config, TPSOResult *result){
+    TEvaluator ev = {NULL, function, data};
+    return run_swarm_soa(&ev, bounds, dimensions - 1, fitness, config, result);
+}
 
-    // Check bounds for 1st dimension
-    if(p->position[0] < bounds[0][0]){
-        p->position[0] = bounds[0][0];
-    }
-    else if(p->position[0] > bounds[0][1]){
-        p->position[0] = bounds[0][1];
-    }
+/**
+ * Particle swarm optimization algorithm for n dimensional functions using single precision swarm
+ * Positions, velocities and personal best positions are floats, so the swarm takes about half
+ * of the memory and vectorized update processes twice as many particles at once.
+ * Function values, global best and all comparisons stay in double precision.
+ * @param function Batch function in which is optimization done, it gets positions as floats and
+ *                 it is called once per iteration for the whole swarm (once per thread for its
+ *                 particles when more than 1 thread is used)
+ * @param data Data passed to every call of the function (can be NULL)
+ * @param bounds Bounds of the function in which will be the function optimized.
+ *               this should be n arrays (where n is the amount of dimensions of
+ *               the optimized function) of 2 values where the 1st one is the
+ *               minimum and second one is the maximum. E.g.: for `x in <0, 5> &
+ *               y in <-10, 10>` the bounds should be `{{0.0, 5.0}, {-10.0, 10.0}}`.
+ * @param dimensions The dimensions of optimized function.
+ *                   Dimensions means how many coordinates are there in the optimized
+ *                   function. E.g.: z = x^2 + y is 3 dimensional - it has 2 variables
+ *                   plus the result (3 dimensions).
+ * @param fitness Fitness functions that determinates if passed in value is better
+ *                than other passed in value
+ * @param config Configuration of the optimization (see pso_config_default)
+ * @param result Result of the optimization is saved here (can be NULL), if its `best_pos` is not NULL,
+ *               the best position is written into it and no memory for it is allocated
+ * @return Array with n (n = dimensions - 1) doubles - the best found coordinates
+ *         (this is `result->best_pos` if it was passed in) or NULL if allocation failed.
+ * @note Only global topology and uniform initialization are used, `topology`, `init`, start points,
+ *       `async`, evaluation cache, checkpoints, constraints and `diameter_eps` are ignored
+ * @note Bounds are rounded to floats
+ */
+double* psondim_batch_float(funcndim_batch_float function, void *data, double bounds[][2], unsigned short dimensions, fit_func fitness, const TPSOConfig *config, TPSOResult *result){
+    return run_swarm_float(function, data, bounds, dimensions - 1, fitness, config, result);
+}
 
-    // Check bounds for 2nd dimension
-    if(p->position[1] < bounds[1][0]){
-        p->position[1] = bounds[1][0];
-    }
-    else if(p->position[1] > bounds[1][1]){
-        p->position[1] = bounds[1][1];
+/**
+ * Multi-objective particle swarm optimization algorithm (MOPSO) for n dimensional functions
+ * All objectives are minimized. Non-dominated positions are kept in bounded archive
+ * and every particle follows a leader chosen from it, less crowded parts of the front
+ * (by adaptive grid over objective space) are preferred. When the archive is full,
+ * member from the most crowded grid cell is replaced.
+ * @param function Batch function computing all objectives, it is called once per iteration for the whole swarm
+ * @param data Data passed to every call of the function (can be NULL)
+ * @param bounds Bounds of the function in which will be the function optimized.
+ *               this should be n arrays (where n is the amount of dimensions of
+ *               the optimized function) of 2 values where the 1st one is the
+ *               minimum and second one is the maximum. E.g.: for `x in <0, 5> &
+ *               y in <-10, 10>` the bounds should be `{{0.0, 5.0}, {-10.0, 10.0}}`.
+ * @param dimensions The dimensions of optimized function (amount of coordinates plus 1).
+ * @param objectives The amount of objectives
+ * @param config Configuration of the optimization (see pso_config_default), `archive_size`
+ *               and `grid_divisions` set the archive
+ * @param front_pos Array for coordinates of the found Pareto front, point after point
+ *                  (`archive_size * (dimensions - 1)` doubles)
+ * @param front_val Array for objective values of the found Pareto front, point after point
+ *                  (`archive_size * objectives` doubles)
+ * @param result Statistics of the optimization are saved here (can be NULL), its `best_pos`
+ *               is not used and `best_value` is NAN
+ * @return The amount of points of the found Pareto front (0 if allocation failed or `archive_size` is 0,
+ *         then the optimization is not run and result is not changed)
+ * @note Optimization runs in calling thread, `topology`, `async`, evaluation cache, checkpoints,
+ *       constraints, start points and stopping criteria other than `time_limit` are not used
+ */
+unsigned int psondim_multi(funcndim_multi function, void *data, double bounds[][2], unsigned short dimensions, unsigned short objectives,
+                           const TPSOConfig *config, double *front_pos, double *front_val, TPSOResult *result){
+    // There is no room for the front
+    if(config->archive_size == 0){
+        return 0;
     }
+    return run_multi(function, data, bounds, dimensions - 1, objectives, config, front_pos, front_val, result);
 }
 
 /**
- * Particle swarm optimization algorithm for 3 dimensional functions
+ * Particle swarm optimization algorithm for n dimensional functions
  * @param function Function in which is optimization done
  * @param bounds Bounds of the function in which will be the function optimized.
- *               this should be 2 arrays of 2 values where the 1st one is
- *               the minimum and second one is the maximum. E.g.: for `x in <0, 5> &
+ *               this should be n arrays (where n is the amount of dimensions of
+ *               the optimized function) of 2 values where the 1st one is the
+ *               minimum and second one is the maximum. E.g.: for `x in <0, 5> &
  *               y in <-10, 10>` the bounds should be `{{0.0, 5.0}, {-10.0, 10.0}}`.
+ * @param dimensions The dimensions of optimized function.
+ *                   Dimensions means how many coordinates are there in the optimized
+ *                   function. E.g.: z = x^2 + y is 3 dimensional - it has 2 variables
+ *                   plus the result (3 dimensions).
  * @param fitness Fitness functions that determinates if passed in value is better
  *                than other passed in value
  * @param particle_am The amount of particles to use for optimization (10 to 20 is
  *                    usually good enough amount for most functions)
  * @param max_iter The amount of iterations that should be done.
  *                 More results in better precision but longer calculation.
- * @return Array with 2 doubles - the best found x and y coordinates.
+ * @return Array with n (n = dimensions - 1) doubles - the best found coordinates.
  */
-double *pso3dim(func3dim function, double bounds[2][2], fit_func fitness, unsigned int particle_am, unsigned long max_iter){
-    // Creating array of particles
-    TParticle3Dim *swarm = malloc(sizeof(TParticle3Dim)*particle_am);
-#ifdef ASSERT_ALLOCATION
-    if(!swarm){
-        error_handler();
-    }
-#endif // ASSERT_ALLOCATION
-    // Set each particle's attributes
-    for(unsigned int i = 0; i < particle_am; i++){
-        init_particle3dim(&(swarm[i]), bounds);
-    }
-
-    double *best_pos = malloc(sizeof(double) * 2);  // Global best position
-#ifdef ASSERT_ALLOCATION
-    if(!best_pos){
-        free(swarm);
-        error_handler();
-    }
-#endif // ASSERT_ALLOCATION
-    double best_value = DBL_MAX;  // Global best value (for best position)
-
-    for(unsigned long i = 0; i < max_iter; i++){
-        for(unsigned int a = 0; a < particle_am; a++){
-            // Evaluate current position of the current particle
-            double value = function(swarm[a].position[0], swarm[a].position[1]);
-            // Check if this is new personal best value
-            if(fitness(value, swarm[a].best_val) || i == 0){
-                // Save the personal best position and value
-                swarm[a].best_val = value;
-                swarm[a].best_pos[0] = swarm[a].position[0];
-                swarm[a].best_pos[1] = swarm[a].position[1];
-                // Now check if the value is better than global best value
-                // This can be inside this if statement because any global best
-                //   has to have better or same fitness function value than 
-                //   any personal best
-                if(fitness(value, best_value) || best_value == DBL_MAX){
-                    best_value = value;
-                    best_pos[0] = swarm[a].position[0];
-                    best_pos[1] = swarm[a].position[1];
-                }
-            }
-        }
-        // Updating the velocity and position of particles
-        for(unsigned int a = 0; a < particle_am; a++){
-            update_particle3dim(&(swarm[a]), bounds, best_pos);      
-        }
-    }
-    
-    // Free allocated memory
-    free(swarm);
-    return best_pos;
+double* psondim(funcndim function, double bounds[][2], unsigned short dimensions, fit_func fitness, unsigned int particle_am, unsigned long max_iter){
+    TPSOConfig config = default_config(particle_am, max_iter);
+    return psondim_config(function, bounds, dimensions, fitness, &config, NULL);
 }
 
 /**
- * Initializes n dimensional particle
- * @param p Particle to be initialized
- * @param bounds Function bounds
- * @param coords How many coordinates need to be initialized (dimensions - 1)
+ * Particle swarm optimization algorithm for n dimensional functions using
+ * structure of arrays swarm storage
+ * @param function Function in which is optimization done
+ * @param bounds Bounds of the function in which will be the function optimized.
+ *               this should be n arrays (where n is the amount of dimensions of
+ *               the optimized function) of 2 values where the 1st one is the
+ *               minimum and second one is the maximum. E.g.: for `x in <0, 5> &
+ *               y in <-10, 10>` the bounds should be `{{0.0, 5.0}, {-10.0, 10.0}}`.
+ * @param dimensions The dimensions of optimized function.
+ *                   Dimensions means how many coordinates are there in the optimized
+ *                   function. E.g.: z = x^2 + y is 3 dimensional - it has 2 variables
+ *                   plus the result (3 dimensions).
+ * @param fitness Fitness functions that determinates if passed in value is better
+ *                than other passed in value
+ * @param particle_am The amount of particles to use for optimization (10 to 20 is
+ *                    usually good enough amount for most functions)
+ * @param max_iter The amount of iterations that should be done.
+ *                 More results in better precision but longer calculation.
+ * @return Array with n (n = dimensions - 1) doubles - the best found coordinates.
+ * @note psondim uses the same engine, this function is its alias
  */
-static void init_particlendim(TParticle *p, double bounds[][2], unsigned short coords){
-   // Set random velocity and position for every dimension
-   for(unsigned short i = 0; i < coords; i++){
-        p->velocity[i] = random_double(-1, 1);
-        p->position[i] = random_double(bounds[i][0], bounds[i][1]);
-   }
+double* psondim_soa(funcndim function, double bounds[][2], unsigned short dimensions, fit_func fitness, unsigned int particle_am, unsigned long max_iter){
+    return psondim(function, bounds, dimensions, fitness, particle_am, max_iter);
 }
 
 /**
- * Update n dimensional particle's velocity and position
- * @param p Particle to be initialized
- * @param bounds Function bounds
- * @param best_pos Best global position
- * @param coords How many coordinates need to be initialized (dimensions - 1)
+ * Particle swarm optimization algorithm for 3 dimensional functions using batch evaluation
+ * @param function Batch function in which is optimization done, it is called
+ *                 once per iteration for the whole swarm
+ * @param data Data passed to every call of the function (can be NULL)
+ * @param bounds Bounds of the function in which will be the function optimized.
+ *               this should be 2 arrays of 2 values where the 1st one is
+ *               the minimum and second one is the maximum. E.g.: for `x in <0, 5> &
+ *               y in <-10, 10>` the bounds should be `{{0.0, 5.0}, {-10.0, 10.0}}`.
+ * @param fitness Fitness functions that determinates if passed in value is better
+ *                than other passed in value
+ * @param particle_am The amount of particles to use for optimization (10 to 20 is
+ *                    usually good enough amount for most functions)
+ * @param max_iter The amount of iterations that should be done.
+ *                 More results in better precision but longer calculation.
+ * @return Array with 2 doubles - the best found x and y coordinates.
  */
-static void update_particlendim(TParticle *p, double bounds[][2], double *best_pos, unsigned short coords){
-    // Random coefficient pre-multiplied by cognitive/social coefficient
-    double rp = random_double(0, 1) * COEFF_CP;
-    double rg = random_double(0, 1) * COEFF_CG;
-
-    // Calculate new velocity for all dimensions
-    // Differences are pre-calculated to avoid calculating them twice
-    for(unsigned short i = 0; i < coords; i++){
-        double pos_diff = best_pos[i] - p->position[i];
-        p->velocity[i] = COEFF_W * p->velocity[i] + rp * pos_diff + rg * pos_diff;
-
-        // Update position of the particle
-        p->position[i] += p->velocity[i];
-
-        // Check if new position is still in bounds
-        if(p->position[i] < bounds[i][0]){
-            p->position[i] = bounds[i][0];
-        }
-        else if(p->position[i] > bounds[i][1]){
-            p->position[i] = bounds[i][1];
-        }
-    }
+double* pso3dim_batch(func3dim_batch function, void *data, double bounds[2][2], fit_func fitness, unsigned int particle_am, unsigned long max_iter){
+    TBatch3dimAdapter adapter = {function, data};
+    TEvaluator ev = {NULL, batch3dim_adapter, &adapter};
+    TPSOConfig config = default_config(particle_am, max_iter);
+    return run_swarm_soa(&ev, bounds, 2, fitness, &config, NULL);
 }
 
 /**
- * Particle swarm optimization algorithm for n dimensional functions
- * @param function Function in which is optimization done
+ * Particle swarm optimization algorithm for n dimensional functions using batch evaluation
+ * @param function Batch function in which is optimization done, it is called
+ *                 once per iteration for the whole swarm
+ * @param data Data passed to every call of the function (can be NULL)
  * @param bounds Bounds of the function in which will be the function optimized.
  *               this should be n arrays (where n is the amount of dimensions of
  *               the optimized function) of 2 values where the 1st one is the
@@ -263,127 +4264,84 @@ static void update_particlendim(TParticle *p, double bounds[][2], double *best_p
  *                 More results in better precision but longer calculation.
  * @return Array with n (n = dimensions - 1) doubles - the best found coordinates.
  */
-double* psondim(funcndim function, double bounds[][2], unsigned short dimensions, fit_func fitness, unsigned int particle_am, unsigned long max_iter){
-    // Adjust dimensions (eg.: 3 dimensions means only 2 coordinates will be saved - 3rd will be the result of this functions)
-    dimensions--; 
-    // Create swarm
-    TParticle *swarm = malloc(sizeof(TParticle)*particle_am);
-#ifdef ASSERT_ALLOCATION
-    if(!swarm){
-        error_handler();
-    }
-#endif // ASSERT_ALLOCATION
-    // Allocate particle attributes to correct dimensions
-    // and set each particle's attributes
-    for(unsigned int i = 0; i < particle_am; i++){
-        // Allocate space for velocity for all dimensions
-        swarm[i].velocity = malloc(sizeof(double)*dimensions);
-#ifdef ASSERT_ALLOCATION
-        if(!swarm[i].velocity){
-            // All previously allocated attributes have to be freed
-            for(unsigned int a = 0; a < i; a++){
-                free(swarm[a].velocity);
-                free(swarm[a].position);
-                free(swarm[a].best_pos);
-            }
-            // Free the array itself
-            free(swarm);
-            // Call error handler
-            error_handler();
-        }
-#endif // ASSERT_ALLOCATION
-        
-        // Allocate space for position for all dimensions
-        swarm[i].position = malloc(sizeof(double)*dimensions);
-#ifdef ASSERT_ALLOCATION
-        if(!swarm[i].position){
-            // All previously allocated attributes have to be freed
-            free(swarm[i].velocity);
-            for(unsigned int a = 0; a < i; a++){
-                free(swarm[a].velocity);
-                free(swarm[a].position);
-                free(swarm[a].best_pos);
-            }
-            // Free the array itself
-            free(swarm);
-            // Call error handler
-            error_handler();
-        }
-#endif // ASSERT_ALLOCATION
-
-        // Allocate space for best position for all dimensions
-        swarm[i].best_pos = malloc(sizeof(double)*dimensions);
-#ifdef ASSERT_ALLOCATION
-        if(!swarm[i].best_pos){
-            // All previously allocated attributes have to be freed
-            free(swarm[i].velocity);
-            free(swarm[i].position);
-            for(unsigned int a = 0; a < i; a++){
-                free(swarm[a].velocity);
-                free(swarm[a].position);
-                free(swarm[a].best_pos);
-            }
-            // Free the array itself
-            free(swarm);
-            // Call error handler
-            error_handler();
-        }
-#endif // ASSERT_ALLOCATION
+double* psondim_batch(funcndim_batch function, void *data, double bounds[][2], unsigned short dimensions, fit_func fitness, unsigned int particle_am, unsigned long max_iter){
+    TPSOConfig config = default_config(particle_am, max_iter);
+    return psondim_batch_config(function, data, bounds, dimensions, fitness, &config, NULL);
+}
 
-        // Initialize the particle
-        init_particlendim(&(swarm[i]), bounds, dimensions);
-    }
+/**
+ * Particle swarm optimization algorithm for n dimensional functions running in multiple threads
+ * @param function Function in which is optimization done, it is called from multiple threads
+ *                 at once, so it has to be thread safe
+ * @param bounds Bounds of the function in which will be the function optimized.
+ *               this should be n arrays (where n is the amount of dimensions of
+ *               the optimized function) of 2 values where the 1st one is the
+ *               minimum and second one is the maximum. E.g.: for `x in <0, 5> &
+ *               y in <-10, 10>` the bounds should be `{{0.0, 5.0}, {-10.0, 10.0}}`.
+ * @param dimensions The dimensions of optimized function.
+ *                   Dimensions means how many coordinates are there in the optimized
+ *                   function. E.g.: z = x^2 + y is 3 dimensional - it has 2 variables
+ *                   plus the result (3 dimensions).
+ * @param fitness Fitness functions that determinates if passed in value is better
+ *                than other passed in value
+ * @param particle_am The amount of particles to use for optimization (10 to 20 is
+ *                    usually good enough amount for most functions)
+ * @param max_iter The amount of iterations that should be done.
+ *                 More results in better precision but longer calculation.
+ * @param threads The amount of threads to split particles across (0 means one thread per
+ *                online processor)
+ * @param seed Seed for pseudo-random generators
+ * @return Array with n (n = dimensions - 1) doubles - the best found coordinates.
+ */
+double* psondim_parallel(funcndim function, double bounds[][2], unsigned short dimensions, fit_func fitness, unsigned int particle_am, unsigned long max_iter, unsigned int threads, uint64_t seed){
+    TPSOConfig config = default_config(particle_am, max_iter);
+    config.threads = threads;
+    config.seed = seed;
+    config.use_seed = true;
+    return psondim_config(function, bounds, dimensions, fitness, &config, NULL);
+}
 
-    double *best_pos = malloc(sizeof(double) * dimensions);  // Global best position
-#ifdef ASSERT_ALLOCATION
-    if(!best_pos){
-    	// Free all previously allocated resources
-        for(unsigned int i = 0; i < particle_am; i++){
-            free(swarm[i].velocity);
-            free(swarm[i].position);
-            free(swarm[i].best_pos);
-        }
-        free(swarm);
-        error_handler();
-    }
-#endif // ASSERT_ALLOCATION
-    double best_value = DBL_MAX;  // Global best value (for best position)
-
-    for(unsigned long i = 0; i < max_iter; i++){
-        for(unsigned int a = 0; a < particle_am; a++){
-            // Evaluate current position of the current particle
-            double value = function(swarm[a].position);
-            // Check if this is new personal best value
-            if(fitness(value, swarm[a].best_val) || i == 0){
-                // Save the personal best position and value
-                swarm[a].best_val = value;
-                // Copying position into personal best position
-                //   memory does not overlap, so memcpy is used
-                memcpy(swarm[a].best_pos, swarm[a].position, sizeof(double)*dimensions);
-                // Now check if the value is better than global best value
-                // This can be inside this if statement because any global best
-                //   has to have better or same fitness function value than
-                //   any personal best
-                if(fitness(value, best_value) || best_value == DBL_MAX){
-                    best_value = value;
-                    memcpy(best_pos, swarm[a].position, sizeof(double)*dimensions);
-                }
-            }
-        }
-        // Updating the velocity and position of particles
-        for(unsigned int a = 0; a < particle_am; a++){
-            update_particlendim(&(swarm[a]), bounds, best_pos, dimensions);
-        }
-    }
+/**
+ * Particle swarm optimization algorithm for 3 dimensional functions
+ * @param function Function in which is optimization done
+ * @param bounds Bounds of the function in which will be the function optimized.
+ *               this should be 2 arrays of 2 values where the 1st one is
+ *               the minimum and second one is the maximum. E.g.: for `x in <0, 5> &
+ *               y in <-10, 10>` the bounds should be `{{0.0, 5.0}, {-10.0, 10.0}}`.
+ * @param fitness Fitness functions that determinates if passed in value is better
+ *                than other passed in value
+ * @param particle_am The amount of particles to use for optimization (10 to 20 is
+ *                    usually good enough amount for most functions)
+ * @param max_iter The amount of iterations that should be done.
+ *                 More results in better precision but longer calculation.
+ * @return Array with 2 doubles - the best found x and y coordinates.
+ */
+double *pso3dim(func3dim function, double bounds[2][2], fit_func fitness, unsigned int particle_am, unsigned long max_iter){
+    TPSOConfig config = default_config(particle_am, max_iter);
+    TEvaluator ev = {NULL, NULL, NULL, function};
+    return run_swarm_soa(&ev, bounds, 2, fitness, &config, NULL);
+}
 
-    // Free allocated memory
-    for(unsigned int i = 0; i < particle_am; i++){
-        free(swarm[i].velocity);
-        free(swarm[i].position);
-        free(swarm[i].best_pos);
-    }
-    free(swarm);
-    return best_pos;
+/**
+ * Runs PSO algorithm for 3 dimensional function with swarm on the stack
+ * @param function Function in which is optimization done
+ * @param bounds Function bounds
+ * @param fitness Fitness function
+ * @param max_iter The amount of iterations that should be done
+ * @return The best found x and y coordinates
+ */
+static inline TPSOxy run_static3dim(func3dim function, double bounds[2][2], fit_func fitness, unsigned long max_iter){
+    TPSOConfig config = default_config(PSO3DIM_STATIC_PARTICLES, max_iter);
+    TEvaluator ev = {NULL, NULL, NULL, function};
+    // Buffer has PSO_BUFFER_SIZE for this fixed configuration, so creation cannot fail
+    _Alignas(SOA_ALIGNMENT) unsigned char buffer[PSO_BUFFER_SIZE(3, PSO3DIM_STATIC_PARTICLES, 1)];
+    TPSOOptimizer *opt = create_optimizer_in(buffer, sizeof(buffer), 2, &config);
+    TPSOResult result = {NULL};
+    run_optimizer(opt, &ev, bounds, fitness, &result);
+    TPSOxy best = {result.best_pos[0], result.best_pos[1]};
+    // Single threaded optimizer in the buffer has no threads and owns no memory, only its lock and condition are destroyed
+    release_optimizer(opt);
+    return best;
 }
 
 /**
@@ -401,44 +4359,7 @@ double* psondim(funcndim function, double bounds[][2], unsigned short dimensions
  * @note The amount of particles is determinated by the value of `PSO3DIM_STATIC_PARTICLES` macro
  */
 TPSOxy pso3dim_static(func3dim function, double bounds[2][2], fit_func fitness, unsigned long max_iter){
-    // Create array of particles (swarm)
-    TParticle3Dim swarm[PSO3DIM_STATIC_PARTICLES];
-    // Initialize the particles
-    for(unsigned int i = 0; i < PSO3DIM_STATIC_PARTICLES; i++){
-        init_particle3dim(&(swarm[i]), bounds);
-    }
-
-    double best_pos[2] = {0.0, 0.0};
-    double best_value = DBL_MAX;
-
-    for(unsigned long i = 0; i < max_iter; i++){
-        for(unsigned int a = 0; a < PSO3DIM_STATIC_PARTICLES; a++){
-            // Evaluate current position of the current particle
-            double value = function(swarm[a].position[0], swarm[a].position[1]);
-            // Check if this is new personal best value
-            if(fitness(value, swarm[a].best_val) || i == 0){
-                // Save the personal best position and value
-                swarm[a].best_val = value;
-                swarm[a].best_pos[0] = swarm[a].position[0];
-                swarm[a].best_pos[1] = swarm[a].position[1];
-                // Now check if the value is better than global best value
-                // This can be inside this if statement because any global best
-                //   has to have better or same fitness function value than
-                //   any personal best
-                if(fitness(value, best_value) || best_value == DBL_MAX){
-                    best_value = value;
-                    best_pos[0] = swarm[a].position[0];
-                    best_pos[1] = swarm[a].position[1];
-                }
-            }
-        }
-        // Updating the velocity and position of particles
-        for(unsigned int a = 0; a < PSO3DIM_STATIC_PARTICLES; a++){
-            update_particle3dim(&(swarm[a]), bounds, best_pos);
-        }
-    }
-
-    return (TPSOxy){best_pos[0], best_pos[1]};
+    return run_static3dim(function, bounds, fitness, max_iter);
 }
 
 /**
@@ -455,83 +4376,8 @@ TPSOxy pso3dim_static(func3dim function, double bounds[2][2], fit_func fitness,
  *                 More results in better precision but longer calculation.
  * @return Struct with 2 doubles - the best found x and y coordinates.
  * @note The amount of particles is determinated by the value of `PSO3DIM_STATIC_PARTICLES` macro
+ * @note This is the same engine as pso3dim_static, it is kept for compatibility
  */
 TPSOxy pso3dim_static_opt(func3dim function, double bounds[2][2], fit_func fitness, unsigned long max_iter){
-    // Create array of particles (swarm)
-    TParticle3Dim swarm[PSO3DIM_STATIC_PARTICLES];
-    // Initialize the particles
-    for(unsigned int i = 0; i < PSO3DIM_STATIC_PARTICLES; i++){
-    	TParticle3Dim *p = &(swarm[i]);
-        // Set values for every dimension
-	    // Random velocity from -1 to 1
-	    p->velocity[0] = random_double(-1, 1);
-	    p->velocity[1] = random_double(-1, 1);
-	    // Random position from minimal possible to maximal and set best position to current
-	    p->best_pos[0] = p->position[0] = random_double(bounds[0][0], bounds[0][1]);
-	    p->best_pos[1] = p->position[1] = random_double(bounds[1][0], bounds[1][1]);
-    }
-
-    double best_pos[2] = {0.0, 0.0};
-    double best_value = DBL_MAX;
-
-    for(unsigned long i = 0; i < max_iter; i++){
-        for(unsigned int a = 0; a < PSO3DIM_STATIC_PARTICLES; a++){
-            // Evaluate current position of the current particle
-            double value = function(swarm[a].position[0], swarm[a].position[1]);
-            // Check if this is new personal best value
-            if(fitness(value, swarm[a].best_val) || i == 0){
-                // Save the personal best position and value
-                swarm[a].best_val = value;
-                swarm[a].best_pos[0] = swarm[a].position[0];
-                swarm[a].best_pos[1] = swarm[a].position[1];
-                // Now check if the value is better than global best value
-                // This can be inside this if statement because any global best
-                //   has to have better or same fitness function value than
-                //   any personal best
-                if(fitness(value, best_value) || best_value == DBL_MAX){
-                    best_value = value;
-                    best_pos[0] = swarm[a].position[0];
-                    best_pos[1] = swarm[a].position[1];
-                }
-            }
-        }
-        // Updating the velocity and position of particles
-        for(unsigned int a = 0; a < PSO3DIM_STATIC_PARTICLES; a++){
-        	TParticle3Dim *p = &(swarm[a]);
-            // Random coefficient pre-multiplied by cognitive/social coefficient
-		    double rp = random_double(0, 1) * COEFF_CP;
-		    double rg = random_double(0, 1) * COEFF_CG;
-
-		    // Calculate new velocity for both dimensions
-		    // Calculating with non-dependent values first to not slow down processing pipeline
-		    // Differences are pre-calculated to avoid calculating them twice
-		    double pos_diff0 = best_pos[0] - p->position[0];
-		    double pos_diff1 = best_pos[1] - p->position[1];
-		    p->velocity[0] = COEFF_W * p->velocity[0] + rp * pos_diff0 + rg * pos_diff0;
-		    p->velocity[1] = COEFF_W * p->velocity[1] + rp * pos_diff1 + rg * pos_diff1;
-
-		    // Calculate new position
-		    // Adjust if new position is out of bounds
-		    p->position[0] += p->velocity[0];
-		    p->position[1] += p->velocity[1];
-
-		    // Check bounds for 1st dimension
-		    if(p->position[0] < bounds[0][0]){
-		        p->position[0] = bounds[0][0];
-		    }
-		    else if(p->position[0] > bounds[0][1]){
-		        p->position[0] = bounds[0][1];
-		    }
-
-		    // Check bounds for 2nd dimension
-		    if(p->position[1] < bounds[1][0]){
-		        p->position[1] = bounds[1][0];
-		    }
-		    else if(p->position[1] > bounds[1][1]){
-		        p->position[1] = bounds[1][1];
-		    }
-        }
-    }
-
-    return (TPSOxy){best_pos[0], best_pos[1]};
+    return run_static3dim(function, bounds, fitness, max_iter);
 }
@@ -25,14 +25,47 @@
 #define _PSO_H_
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 //#define ASSERT_ALLOCATION  //< If this is defined, every allocation will be checked if it was successful
 
 #define PSO3DIM_STATIC_PARTICLES 40  //< How many particles will be used in pso3dim_static function
 
-#define COEFF_W  0.50  //< Inertia coefficient (should be in range of <0.4, 0.9>)
-#define COEFF_CP 2.05  //< Cognitive coefficient (should be a little bit above 2)
-#define COEFF_CG 2.05  //< Social coefficient (should have same or similar value as cognitive coefficient)
+#define PSO_OPTIMIZER_SIZE 4096  //< Upper bound of size of optimizer state in bytes (see PSO_BUFFER_SIZE)
+#define PSO_WORKER_SIZE 512      //< Upper bound of size of state of one worker thread in bytes (see PSO_BUFFER_SIZE)
+#define PSO_ROUND_UP8(amount) ((((size_t)(amount)) + 7) / 8 * 8)  //< Rounds up amount of doubles to whole cache lines
+
+/**
+ * Size of buffer which is always big enough for pso_create_in
+ * Can be used for buffers with static or automatic storage duration.
+ * Random topology needs additional PSO_LINKS_SIZE bytes, evaluation cache PSO_CACHE_SIZE bytes
+ * and constraints PSO_CONSTRAINTS_SIZE bytes.
+ */
+#define PSO_BUFFER_SIZE(dimensions, particle_am, threads) \
+    (128 + PSO_OPTIMIZER_SIZE + 2 * sizeof(double) * PSO_ROUND_UP8((dimensions) - 1) + \
+     ((threads) > 1 ? (size_t)(threads) * PSO_WORKER_SIZE : 0) + \
+     sizeof(double) * (PSO_ROUND_UP8(particle_am) * (4 * ((size_t)(dimensions) - 1) + 5) + 3 * PSO_ROUND_UP8((dimensions) - 1) * (size_t)(threads)) + \
+     sizeof(unsigned int) * PSO_ROUND_UP8(particle_am))
+
+/**
+ * Size of random neighbors for PSO_BUFFER_SIZE (with random topology)
+ */
+#define PSO_LINKS_SIZE(particle_am, neighbors) (sizeof(unsigned int) * PSO_ROUND_UP8(particle_am) * (neighbors))
+
+/**
+ * Size of evaluation caches for PSO_BUFFER_SIZE (with cache_size entries per thread, which has to be power of 2)
+ */
+#define PSO_CACHE_SIZE(dimensions, cache_size, threads) (sizeof(double) * (size_t)(cache_size) * ((dimensions) + 1) * (threads))
+
+/**
+ * Size of constraint values and violations for PSO_BUFFER_SIZE (with `ineq_am + eq_am` constraints)
+ */
+#define PSO_CONSTRAINTS_SIZE(particle_am, constraints) (sizeof(double) * PSO_ROUND_UP8(particle_am) * ((constraints) + 2))
+
+#define COEFF_W  0.50  //< Default inertia coefficient (should be in range of <0.4, 0.9>)
+#define COEFF_CP 2.05  //< Default cognitive coefficient (should be a little bit above 2)
+#define COEFF_CG 2.05  //< Default social coefficient (should have same or similar value as cognitive coefficient)
 
 /**
  * Return type for statical PSO
@@ -63,6 +96,308 @@ typedef double (* func3dim)(double, double);
  */
 typedef double (* funcndim)(double *);
 
+/**
+ * 3 dimensional batch function
+ * Parameters are array of x values, array of y values, amount of
+ * points, array into which function values are written and user data
+ * Value for point `(x[i], y[i])` is written into `values[i]`
+ */
+typedef void (* func3dim_batch)(const double *, const double *, unsigned int, double *, void *);
+
+/**
+ * N dimensional batch function
+ * Parameters are matrix of positions, length of a matrix row (stride),
+ * amount of coordinates, amount of points, array into which function
+ * values are written and user data
+ * Matrix of positions is stored coordinate by coordinate, so coordinate
+ * `c` of point `i` is `positions[c*stride + i]` and its value is
+ * written into `values[i]`
+ */
+typedef void (* funcndim_batch)(const double *, size_t, unsigned short, unsigned int, double *, void *);
+
+/**
+ * N dimensional batch function with single precision positions (see psondim_batch_float)
+ * Parameters are the same as for funcndim_batch, only matrix of positions is of floats
+ */
+typedef void (* funcndim_batch_float)(const float *, size_t, unsigned short, unsigned int, double *, void *);
+
+/**
+ * N dimensional batch function with more objectives (see psondim_multi)
+ * Parameters are the same as for funcndim_batch, only values of all objectives are
+ * written into matrix with the same stride, value of objective `m` at point `i`
+ * is written into `objectives[m*stride + i]`
+ */
+typedef void (* funcndim_multi)(const double *, size_t, unsigned short, unsigned int, double *, void *);
+
+/**
+ * Constraints function (see `constraints` of TPSOConfig)
+ * Parameters are matrix of positions (the same as for funcndim_batch), length of a matrix row
+ * (stride), amount of coordinates, amount of points, matrix into which constraint values are
+ * written and user data.
+ * Value of constraint `k` at point `i` is written into `constraints[k*stride + i]`, the 1st
+ * `ineq_am` constraints are inequalities `g(x) <= 0`, the next `eq_am` are equalities `h(x) = 0`.
+ * It is called for the same points just before the objective in the same thread, so batch
+ * objective can reuse intermediate results kept in user data.
+ * Violation of a point is the sum of positive `g(x)` and of `|h(x)|` above `eq_tol`. Bests are
+ * compared by feasibility rules: feasible point is better than infeasible one, infeasible points
+ * are compared by violation and feasible ones by their function values.
+ */
+typedef void (* constr_func)(const double *, size_t, unsigned short, unsigned int, double *, void *);
+
+/**
+ * Function submitting particle position for evaluation (see pso_run_submit)
+ * Parameters are index of the particle, array of its coordinates and user data
+ * The value has to be passed to pso_complete once it is known, coordinates
+ * stay valid until then
+ */
+typedef void (* submit_func)(unsigned int, const double *, void *);
+
+/**
+ * State of pseudo-random generator (xoshiro256**)
+ * Every optimization call uses its own generator, so calls running
+ * in parallel do not share any state and can be reproduced from seed
+ */
+typedef struct {
+    uint64_t s[4];  //< Generator state
+} TPSORng;
+/**
+ * Instruction sets which can be used by vectorized parts of the engine
+ */
+typedef enum {
+    PSO_ISA_AUTO = -1,  //< Best instruction set supported by the processor
+    PSO_ISA_SCALAR,     //< Plain C code
+    PSO_ISA_SSE2,       //< SSE2 (x86)
+    PSO_ISA_AVX2,       //< AVX2 (x86)
+    PSO_ISA_AVX512,     //< AVX-512F (x86)
+    PSO_ISA_NEON        //< NEON (aarch64)
+} TPSOIsa;
+
+/**
+ * How a coefficient changes over iterations
+ */
+typedef enum {
+    PSO_SCHEDULE_CONSTANT,  //< Coefficient has the same value in all iterations
+    PSO_SCHEDULE_LINEAR     //< Coefficient changes linearly from start value in 1st iteration to end value in the last one
+} TPSOSchedule;
+
+/**
+ * Neighborhood topology of the swarm
+ * Determinates which particles affect social part of particle's velocity
+ */
+typedef enum {
+    PSO_TOPOLOGY_GLOBAL,       //< All particles are attracted by one global best position
+    PSO_TOPOLOGY_RING,         //< Particle is attracted by the best of `neighbors` particles on each side in the ring of particles (1 if 0)
+    PSO_TOPOLOGY_VON_NEUMANN,  //< Particle is attracted by the best of 4 neighbors in grid (torus) of particles
+    PSO_TOPOLOGY_RANDOM        //< Particle is attracted by the best of `neighbors` randomly chosen particles (3 if 0)
+} TPSOTopology;
+
+/**
+ * Velocity update formula
+ */
+typedef enum {
+    PSO_UPDATE_CANONICAL,     //< v = w*v + cp*rp*(personal best - x) + cg*rg*(social best - x)
+    PSO_UPDATE_CONSTRICTION,  //< Canonical update multiplied by Clerc's constriction factor computed from cp + cg (which should be above 4), coeff_w is not used
+    PSO_UPDATE_LEGACY         //< Both terms are attracted by social best (personal best is not used), as in the module's original functions
+} TPSOUpdate;
+
+/**
+ * What happens with particle which crossed bounds
+ */
+typedef enum {
+    PSO_BOUNDARY_CLAMP,    //< Position is clamped to the bound, velocity is kept
+    PSO_BOUNDARY_ABSORB,   //< Position is clamped to the bound, velocity is zeroed
+    PSO_BOUNDARY_REFLECT,  //< Position is mirrored at the bound, velocity is reversed
+    PSO_BOUNDARY_REINIT    //< Coordinate gets random value within bounds, velocity is zeroed
+} TPSOBoundary;
+
+/**
+ * How particles are placed at the start of optimization
+ * Low-discrepancy point sets cover the bounds evenly even with few particles,
+ * they are randomized differently in every run.
+ */
+typedef enum {
+    PSO_INIT_UNIFORM,  //< Independent uniformly distributed positions
+    PSO_INIT_HALTON,   //< Randomly shifted Halton sequence (evenness decreases with many coordinates)
+    PSO_INIT_SOBOL,    //< Digitally shifted Sobol sequence (coordinates after the 21st use Latin hypercube)
+    PSO_INIT_LATIN     //< Latin hypercube (each particle has its own interval in every coordinate)
+} TPSOInit;
+
+/**
+ * How 2 function values are compared
+ */
+typedef enum {
+    PSO_MODE_FITNESS,   //< Fitness function passed to the optimization is called (pso_less and pso_greater are recognized)
+    PSO_MODE_MINIMIZE,  //< Lower value is better (fitness function is not used and can be NULL)
+    PSO_MODE_MAXIMIZE   //< Higher value is better (fitness function is not used and can be NULL)
+} TPSOMode;
+
+/**
+ * Configuration of optimization
+ * Should be initialized by pso_config_default and then only
+ * needed values should be changed.
+ */
+typedef struct {
+    double coeff_w;           //< Inertia coefficient (at the 1st iteration when it is not constant)
+    double coeff_w_end;       //< Inertia coefficient at the last iteration (used by PSO_SCHEDULE_LINEAR)
+    TPSOSchedule w_schedule;  //< How inertia coefficient changes (linearly decreasing inertia (e.g. 0.9 to 0.4) converges faster)
+    double coeff_cp;          //< Cognitive coefficient
+    double coeff_cg;          //< Social coefficient
+    TPSOUpdate update;        //< Velocity update formula
+    double vmax_fraction;     //< Velocity in each coordinate is limited to this fraction of its bounds range (0 to disable)
+    const double *vmax;       //< Velocity limit of each coordinate (used instead of vmax_fraction if not NULL, has to be valid during optimization)
+    TPSOBoundary boundary;    //< Handling of particles which crossed bounds (in the crossed coordinate)
+    unsigned int cache_size;  //< Entries of evaluation cache of each thread, rounded up to power of 2 (0 to disable, see PSO_CACHE_SIZE)
+    double cache_tol;         //< Positions are cached quantized to multiples of this (0 for exact positions only)
+    bool async;               //< Each particle is updated as soon as its own evaluation finishes (pso_run only, see pso_run_submit)
+    unsigned int particle_am; //< The amount of particles
+    TPSOInit init;            //< How particles are placed at the start (start points and carry_over take precedence)
+    const double *start_points;  //< Points the first start_am particles start at, point after point (NULL to disable, has to be valid during optimization)
+    unsigned int start_am;    //< The amount of start points (points after particle_am are not used)
+    double start_jitter;      //< Standard deviation of Gaussian noise added to start points as fraction of bounds range (0 to start exactly at them)
+    bool carry_over;          //< Run of reusable optimizer starts from positions and velocities left by its previous run (with the same particle amount)
+    unsigned long max_iter;   //< The amount of iterations that should be done
+    TPSOTopology topology;    //< Neighborhood topology (local topologies converge slower, but rather escape local optima)
+    unsigned int neighbors;   //< The amount of neighbors for ring and random topologies (0 for their default)
+    TPSOMode mode;            //< How function values are compared (NULL fitness function means minimization)
+    unsigned int threads;     //< The amount of threads to split particles across (0 means one per online processor, async runs can use one per particle)
+    uint64_t seed;            //< Seed for pseudo-random generators (used only if use_seed is true)
+    bool use_seed;            //< If false, seed is chosen as for calls without explicit seed (see pso_init)
+    double target_value;      //< Optimization stops once the best value is the same or better than this (if use_target is true)
+    bool use_target;          //< If target_value should be used as stopping criterion
+    unsigned long stagnation_iter;  //< Optimization stops when the best value did not improve for this many iterations (0 to disable)
+    double stagnation_tol;    //< Changes of the best value not bigger than this are not considered as improvement
+    double diameter_eps;      //< Optimization stops when diameter of the swarm is below this (0 to disable)
+    double time_limit;        //< Optimization stops after this many seconds (0 to disable)
+    unsigned int islands;     //< The amount of sub-swarms of psondim_islands, each with particle_am particles and own thread (0 means one per online processor)
+    unsigned long migration_iter;  //< Islands exchange their best particles after this many iterations (0 for isolated islands)
+    bool pin_islands;         //< Thread of each island is pinned to one processor (Linux only)
+    const char *checkpoint_path;   //< File swarm state is saved into (NULL to disable, has to be valid during optimization, see pso_resume)
+    unsigned long checkpoint_iter; //< Swarm state is saved after every this many iterations (0 to disable, not used by async runs and islands)
+    bool resume;              //< Run continues from checkpoint_path if it holds checkpoint of the same configuration
+    constr_func constraints;  //< Function computing constraints (NULL for box bounds only, makes runs synchronous, not used by pso_run_submit)
+    void *constraints_data;   //< Data passed to constraints function
+    unsigned short ineq_am;   //< The amount of inequality constraints
+    unsigned short eq_am;     //< The amount of equality constraints
+    double eq_tol;            //< Equality constraint is satisfied when its absolute value is not above this
+    double skip_violation;    //< Per particle objective is not evaluated at positions with constraint violation above this (INFINITY to evaluate all)
+    unsigned int archive_size;     //< Capacity of Pareto archive of psondim_multi (0 means that nothing is optimized)
+    unsigned int grid_divisions;   //< Cells of archive grid in each objective (psondim_multi)
+} TPSOConfig;
+
+/**
+ * Reason for stopping the optimization
+ */
+typedef enum {
+    PSO_STOP_MAX_ITER,    //< All `max_iter` iterations were done
+    PSO_STOP_TARGET,      //< Target value was reached
+    PSO_STOP_STAGNATION,  //< Best value did not improve for `stagnation_iter` iterations
+    PSO_STOP_DIAMETER,    //< Swarm diameter got below `diameter_eps`
+    PSO_STOP_TIME         //< Time limit was reached
+} TPSOStop;
+
+/**
+ * Result of optimization
+ * Member `best_pos` has to be set before the optimization is called,
+ * all other members are only written by the optimization.
+ */
+typedef struct {
+    double *best_pos;           //< Caller storage for the best position (n doubles), if NULL it will be allocated and has to be freed by caller
+    double best_value;          //< Function value at the best position (NAN if its evaluation was skipped or max_iter is 0, then best position is zeroed)
+    double violation;           //< Constraint violation at the best position (0 if it is feasible)
+    unsigned long evaluations;  //< The amount of function evaluations
+    unsigned long cache_hits;   //< The amount of evaluations answered by cache (not counted in evaluations)
+    unsigned long cache_misses; //< The amount of evaluations not found in cache (0 when cache is not used)
+    unsigned long skipped;      //< The amount of evaluations skipped at positions with violation above skip_violation (not counted in evaluations)
+    unsigned long iterations;   //< The amount of done iterations
+    unsigned long checkpoints;  //< The amount of written checkpoints
+    double elapsed;             //< Time the optimization took in seconds
+    TPSOStop stop;              //< Reason for stopping
+} TPSOResult;
+
+/**
+ * Reusable optimizer
+ * Keeps swarm buffers and worker threads between runs,
+ * every run initializes particles again in already allocated memory.
+ */
+typedef struct TPSOOptimizer TPSOOptimizer;
+
+#ifdef PSO_INSTRUMENT
+#define PSO_INSTRUMENT_COORDS 64  //< Coordinates with own clamp hit counter (hits of later coordinates are added to the last one)
+
+/**
+ * Measured phases of an iteration
+ */
+typedef enum {
+    PSO_PHASE_EVALUATE,  //< Function evaluation
+    PSO_PHASE_BESTS,     //< Personal, neighborhood and global best update
+    PSO_PHASE_UPDATE,    //< Velocity and position update including bounds handling (it is fused into one pass)
+    PSO_PHASES           //< The amount of phases
+} TPSOPhase;
+
+/**
+ * Counters of instrumented build (compiled with PSO_INSTRUMENT)
+ * Counters are summed over all runs and threads since the last pso_instrument_reset
+ */
+typedef struct {
+    uint64_t ticks[PSO_PHASES];  //< Time stamp counter ticks of each phase (nanoseconds where there is no such counter)
+    uint64_t clamp_hits[PSO_INSTRUMENT_COORDS];  //< Particles left on a bound after update in each coordinate
+    uint64_t iterations;         //< The amount of iterations
+} TPSOStats;
+
+/**
+ * Function called after every iteration of instrumented build
+ * Parameters are finished iteration (from 0), the best value, the best position and user data
+ * @note It is called from the thread running the optimization (island threads for island model)
+ */
+typedef void (* iter_func)(unsigned long, double, const double *, void *);
+
+/**
+ * Reads counters
+ * @param stats Counters are saved here
+ */
+void pso_instrument_stats(TPSOStats *stats);
+
+/**
+ * Sets all counters to 0
+ */
+void pso_instrument_reset();
+
+/**
+ * Sets function called after every iteration of every optimization
+ * @param callback Function (NULL to disable)
+ * @param data Data passed to the function
+ */
+void pso_instrument_callback(iter_func callback, void *data);
+
+/**
+ * Reads time stamp counter (used by instrumented code)
+ * @return Current ticks
+ */
+uint64_t pso_instrument_ticks();
+
+/**
+ * Adds ticks to phase counter (used by instrumented code)
+ * @param phase Phase
+ * @param ticks Ticks
+ */
+void pso_instrument_phase(TPSOPhase phase, uint64_t ticks);
+
+/**
+ * Adds clamp hits of coordinate (used by instrumented code)
+ * @param coord Coordinate
+ * @param hits The amount of particles left on a bound
+ */
+void pso_instrument_clamp(unsigned short coord, uint64_t hits);
+
+/**
+ * Reports finished iteration (used by instrumented code)
+ * @param i Finished iteration
+ * @param best_value The best value
+ * @param best_pos The best position
+ */
+void pso_instrument_iteration(unsigned long i, double best_value, const double *best_pos);
+
+#endif // PSO_INSTRUMENT
 
 #ifdef ASSERT_ALLOCATION
 /**
@@ -77,10 +412,102 @@ void __attribute__((weak)) error_handler();
 /**
  * Initializer function for PSO module
  * @warning This function should be called only once before any other PSO function is called
- * @note This function calls srand function
+ * @note This function sets seed used by calls without explicit seed from current time
  */
 void pso_init();
 
+/**
+ * Initializer function for PSO module with explicit seed
+ * Calls without explicit seed are then reproducible (when done in the same order)
+ * @param seed Seed from which seeds of the calls are derived
+ */
+void pso_init_seed(uint64_t seed);
+
+/**
+ * Seeds pseudo-random generator
+ * Seed is expanded using splitmix64, so that any seed (even 0) gives good state
+ * @param rng Generator state
+ * @param seed Seed
+ */
+void pso_rng_seed(TPSORng *rng, uint64_t seed);
+
+/**
+ * Moves pseudo-random generator 2^128 numbers forward
+ * This can be used to create non-overlapping sequences for multiple threads
+ * @param rng Generator state
+ */
+void pso_rng_jump(TPSORng *rng);
+
+/**
+ * Generates random 64 bit number
+ * @param rng Generator state
+ * @return random number
+ */
+uint64_t pso_rng_next(TPSORng *rng);
+
+/**
+ * Generates random double in passed in range
+ * @param rng Generator state
+ * @param min Minimal value of generated number
+ * @param max Maximal value of generated number
+ * @return random double in range of <min, max)
+ */
+double pso_rng_double(TPSORng *rng, double min, double max);
+
+/**
+ * Fitness function for minimization (recognized by the engine, which then does not call it)
+ * @param a 1st value
+ * @param b 2nd value
+ * @return true if a is less than b
+ */
+bool pso_less(double a, double b);
+
+/**
+ * Fitness function for maximization (recognized by the engine, which then does not call it)
+ * @param a 1st value
+ * @param b 2nd value
+ * @return true if a is greater than b
+ */
+bool pso_greater(double a, double b);
+
+/**
+ * Seeds pseudo-random generator as calls without explicit seed do
+ * @param rng Generator state
+ */
+void pso_rng_default(TPSORng *rng);
+
+/**
+ * Checks if instruction set can be used on this processor
+ * @param isa Instruction set
+ * @return true if it is supported
+ */
+bool pso_isa_supported(TPSOIsa isa);
+
+/**
+ * Sets instruction set used by vectorized parts of PSO module
+ * By default the best supported instruction set is chosen at first use,
+ * this function allows to measure effects of different instruction sets.
+ * Results do not depend on used instruction set.
+ * @param isa Instruction set, PSO_ISA_AUTO chooses the best supported one
+ * @return true if instruction set is supported and was set
+ */
+bool pso_set_isa(TPSOIsa isa);
+
+/**
+ * Returns instruction set used by vectorized parts of PSO module
+ * @return Used instruction set
+ */
+TPSOIsa pso_get_isa();
+
+/**
+ * Sets configuration to default values
+ * Coefficients are set to values of COEFF_W, COEFF_CP and COEFF_CG macros,
+ * inertia is constant, global topology is used, optimization runs in 1 thread,
+ * is seeded as calls without explicit seed and always does all iterations.
+ * @param config Configuration to be set
+ */
+void pso_config_default(TPSOConfig *config);
+
 /**
  * Particle swarm optimization algorithm for 3 dimensional functions
  * @param function Function in which is optimization done
@@ -117,9 +544,366 @@ double* pso3dim(func3dim function, double bounds[2][2], fit_func fitness, unsign
  * @param max_iter The amount of iterations that should be done.
  *                 More results in better precision but longer calculation.
  * @return Array with n (n = dimensions - 1) doubles - the best found coordinates.
+ * @note This function uses default configuration (see psondim_config)
  */
 double* psondim(funcndim function, double bounds[][2], unsigned short dimensions, fit_func fitness, unsigned int particle_am, unsigned long max_iter);
 
+/**
+ * Particle swarm optimization algorithm for n dimensional functions with configuration
+ * @param function Function in which is optimization done
+ * @param bounds Bounds of the function in which will be the function optimized.
+ *               this should be n arrays (where n is the amount of dimensions of
+ *               the optimized function) of 2 values where the 1st one is the
+ *               minimum and second one is the maximum. E.g.: for `x in <0, 5> &
+ *               y in <-10, 10>` the bounds should be `{{0.0, 5.0}, {-10.0, 10.0}}`.
+ * @param dimensions The dimensions of optimized function.
+ *                   Dimensions means how many coordinates are there in the optimized
+ *                   function. E.g.: z = x^2 + y is 3 dimensional - it has 2 variables
+ *                   plus the result (3 dimensions).
+ * @param fitness Fitness functions that determinates if passed in value is better
+ *                than other passed in value
+ * @param config Configuration of the optimization (see pso_config_default)
+ * @param result Result of the optimization is saved here (can be NULL), if its `best_pos` is not NULL,
+ *               the best position is written into it and no memory for it is allocated
+ * @return Array with n (n = dimensions - 1) doubles - the best found coordinates
+ *         (this is `result->best_pos` if it was passed in).
+ * @note When more than 1 thread is used, function has to be thread safe
+ * @note Diameter used for stopping is diagonal of the bounding box of all particles
+ */
+double* psondim_config(funcndim function, double bounds[][2], unsigned short dimensions, fit_func fitness, const TPSOConfig *config, TPSOResult *result);
+
+/**
+ * Particle swarm optimization algorithm for n dimensional functions using batch evaluation with configuration
+ * @param function Batch function in which is optimization done, it is called
+ *                 once per iteration for the whole swarm (once per thread for its
+ *                 particles when more than 1 thread is used)
+ * @param data Data passed to every call of the function (can be NULL)
+ * @param bounds Bounds of the function in which will be the function optimized.
+ *               this should be n arrays (where n is the amount of dimensions of
+ *               the optimized function) of 2 values where the 1st one is the
+ *               minimum and second one is the maximum. E.g.: for `x in <0, 5> &
+ *               y in <-10, 10>` the bounds should be `{{0.0, 5.0}, {-10.0, 10.0}}`.
+ * @param dimensions The dimensions of optimized function.
+ *                   Dimensions means how many coordinates are there in the optimized
+ *                   function. E.g.: z = x^2 + y is 3 dimensional - it has 2 variables
+ *                   plus the result (3 dimensions).
+ * @param fitness Fitness functions that determinates if passed in value is better
+ *                than other passed in value
+ * @param config Configuration of the optimization (see pso_config_default)
+ * @param result Result of the optimization is saved here (can be NULL), if its `best_pos` is not NULL,
+ *               the best position is written into it and no memory for it is allocated
+ * @return Array with n (n = dimensions - 1) doubles - the best found coordinates
+ *         (this is `result->best_pos` if it was passed in).
+ */
+double* psondim_batch_config(funcndim_batch function, void *data, double bounds[][2], unsigned short dimensions, fit_func fitness, const TPSOConfig *config, TPSOResult *result);
+
+/**
+ * Particle swarm optimization algorithm for n dimensional functions using single precision swarm
+ * Positions, velocities and personal best positions are floats, so the swarm takes about half
+ * of the memory and vectorized update processes twice as many particles at once.
+ * Function values, global best and all comparisons stay in double precision.
+ * @param function Batch function in which is optimization done, it gets positions as floats and
+ *                 it is called once per iteration for the whole swarm (once per thread for its
+ *                 particles when more than 1 thread is used)
+ * @param data Data passed to every call of the function (can be NULL)
+ * @param bounds Bounds of the function in which will be the function optimized.
+ *               this should be n arrays (where n is the amount of dimensions of
+ *               the optimized function) of 2 values where the 1st one is the
+ *               minimum and second one is the maximum. E.g.: for `x in <0, 5> &
+ *               y in <-10, 10>` the bounds should be `{{0.0, 5.0}, {-10.0, 10.0}}`.
+ * @param dimensions The dimensions of optimized function.
+ *                   Dimensions means how many coordinates are there in the optimized
+ *                   function. E.g.: z = x^2 + y is 3 dimensional - it has 2 variables
+ *                   plus the result (3 dimensions).
+ * @param fitness Fitness functions that determinates if passed in value is better
+ *                than other passed in value
+ * @param config Configuration of the optimization (see pso_config_default)
+ * @param result Result of the optimization is saved here (can be NULL), if its `best_pos` is not NULL,
+ *               the best position is written into it and no memory for it is allocated
+ * @return Array with n (n = dimensions - 1) doubles - the best found coordinates
+ *         (this is `result->best_pos` if it was passed in) or NULL if allocation failed.
+ * @note Only global topology and uniform initialization are used, `topology`, `init`, start points,
+ *       `async`, evaluation cache, checkpoints, constraints and `diameter_eps` are ignored
+ * @note Bounds are rounded to floats
+ */
+double* psondim_batch_float(funcndim_batch_float function, void *data, double bounds[][2], unsigned short dimensions, fit_func fitness, const TPSOConfig *config, TPSOResult *result);
+
+/**
+ * Multi-objective particle swarm optimization algorithm (MOPSO) for n dimensional functions
+ * All objectives are minimized. Non-dominated positions are kept in bounded archive
+ * and every particle follows a leader chosen from it, less crowded parts of the front
+ * (by adaptive grid over objective space) are preferred. When the archive is full,
+ * member from the most crowded grid cell is replaced.
+ * @param function Batch function computing all objectives, it is called once per iteration for the whole swarm
+ * @param data Data passed to every call of the function (can be NULL)
+ * @param bounds Bounds of the function in which will be the function optimized.
+ *               this should be n arrays (where n is the amount of dimensions of
+ *               the optimized function) of 2 values where the 1st one is the
+ *               minimum and second one is the maximum. E.g.: for `x in <0, 5> &
+ *               y in <-10, 10>` the bounds should be `{{0.0, 5.0}, {-10.0, 10.0}}`.
+ * @param dimensions The dimensions of optimized function (amount of coordinates plus 1).
+ * @param objectives The amount of objectives
+ * @param config Configuration of the optimization (see pso_config_default), `archive_size`
+ *               and `grid_divisions` set the archive
+ * @param front_pos Array for coordinates of the found Pareto front, point after point
+ *                  (`archive_size * (dimensions - 1)` doubles)
+ * @param front_val Array for objective values of the found Pareto front, point after point
+ *                  (`archive_size * objectives` doubles)
+ * @param result Statistics of the optimization are saved here (can be NULL), its `best_pos`
+ *               is not used and `best_value` is NAN
+ * @return The amount of points of the found Pareto front (0 if allocation failed or `archive_size` is 0,
+ *         then the optimization is not run and result is not changed)
+ * @note Optimization runs in calling thread, `topology`, `async`, evaluation cache, checkpoints,
+ *       constraints, start points and stopping criteria other than `time_limit` are not used
+ */
+unsigned int psondim_multi(funcndim_multi function, void *data, double bounds[][2], unsigned short dimensions, unsigned short objectives,
+                           const TPSOConfig *config, double *front_pos, double *front_val, TPSOResult *result);
+
+/**
+ * Particle swarm optimization algorithm with island model
+ * Several independent swarms (islands) run in their own threads. Every `migration_iter`
+ * iterations each island publishes its best particle and the next island (islands form
+ * a ring) takes it instead of its worst particle, if it is better. Particles are passed
+ * through lock-free mailboxes, so islands never wait for each other and share no
+ * memory between migrations. Each island checks stopping criteria on its own.
+ * @param function Function in which is optimization done (has to be thread safe)
+ * @param bounds Bounds of the function in which will be the function optimized.
+ *               this should be n arrays (where n is the amount of dimensions of
+ *               the optimized function) of 2 values where the 1st one is the
+ *               minimum and second one is the maximum. E.g.: for `x in <0, 5> &
+ *               y in <-10, 10>` the bounds should be `{{0.0, 5.0}, {-10.0, 10.0}}`.
+ * @param dimensions The dimensions of optimized function.
+ *                   Dimensions means how many coordinates are there in the optimized
+ *                   function. E.g.: z = x^2 + y is 3 dimensional - it has 2 variables
+ *                   plus the result (3 dimensions).
+ * @param fitness Fitness functions that determinates if passed in value is better
+ *                than other passed in value
+ * @param config Configuration of every island (`threads` and `async` are not used) and
+ *               of the island model (see pso_config_default)
+ * @param result Result of the optimization is saved here (can be NULL), if its `best_pos` is not NULL,
+ *               the best position is written into it and no memory for it is allocated.
+ *               Result of the best island is used, evaluations are summed over all islands
+ *               and iterations is the most iterations done by an island.
+ * @return Array with n (n = dimensions - 1) doubles - the best found coordinates
+ *         (this is `result->best_pos` if it was passed in) or NULL if allocation failed.
+ */
+double* psondim_islands(funcndim function, double bounds[][2], unsigned short dimensions, fit_func fitness, const TPSOConfig *config, TPSOResult *result);
+
+/**
+ * Creates reusable optimizer
+ * @param dimensions The dimensions of optimized functions (amount of coordinates plus 1)
+ * @param config Configuration of the optimizer (see pso_config_default)
+ * @return New optimizer or NULL if allocation failed
+ */
+TPSOOptimizer *pso_create(unsigned short dimensions, const TPSOConfig *config);
+
+/**
+ * Computes size of buffer needed by pso_create_in
+ * @param dimensions The dimensions of optimized functions (amount of coordinates plus 1)
+ * @param config Configuration of the optimizer
+ * @return Size in bytes
+ */
+size_t pso_buffer_size(unsigned short dimensions, const TPSOConfig *config);
+
+/**
+ * Creates reusable optimizer in caller buffer
+ * Optimizer does not allocate any memory, buffer has to stay valid until pso_destroy is called
+ * @param buffer Buffer (no alignment is needed)
+ * @param size Size of the buffer in bytes (see pso_buffer_size and PSO_BUFFER_SIZE)
+ * @param dimensions The dimensions of optimized functions (amount of coordinates plus 1)
+ * @param config Configuration of the optimizer (see pso_config_default)
+ * @return New optimizer or NULL if the buffer is too small
+ * @note pso_reset fails if new configuration does not fit into the buffer
+ */
+TPSOOptimizer *pso_create_in(void *buffer, size_t size, unsigned short dimensions, const TPSOConfig *config);
+
+/**
+ * Resets optimizer
+ * @param opt Optimizer
+ * @param config New configuration or NULL to keep the current one
+ * @return false if allocation failed (optimizer then cannot be used until successful reset)
+ */
+bool pso_reset(TPSOOptimizer *opt, const TPSOConfig *config);
+
+/**
+ * Loads checkpoint written by optimizer (see `checkpoint_path` in TPSOConfig)
+ * The next synchronous run of the optimizer continues the checkpointed run from
+ * the iteration after the checkpoint, no position is evaluated again.
+ * It has to be run with the same function, bounds and configuration. Evaluations and
+ * iterations in its result include those done before the checkpoint.
+ * @param opt Optimizer
+ * @param path Path of the checkpoint file
+ * @return false if the file cannot be read or it was written by optimizer with
+ *         different dimensions, particle amount, threads or topology
+ */
+bool pso_resume(TPSOOptimizer *opt, const char *path);
+
+/**
+ * Runs optimization using reusable optimizer
+ * With `async` set in configuration, every thread takes the next updated particle
+ * as soon as it finished its evaluation (see pso_run_submit)
+ * @param opt Optimizer
+ * @param function Function in which is optimization done
+ * @param bounds Bounds of the function in which will be the function optimized
+ *               (n arrays of minimum and maximum)
+ * @param fitness Fitness functions that determinates if passed in value is better
+ *                than other passed in value
+ * @param result Result of the optimization is saved here (can be NULL), if its `best_pos` is not NULL,
+ *               the best position is copied into it, otherwise it is set to optimizer's storage,
+ *               which is valid until next run or destruction of the optimizer
+ */
+void pso_run(TPSOOptimizer *opt, funcndim function, double bounds[][2], fit_func fitness, TPSOResult *result);
+
+/**
+ * Runs optimization with batch function using reusable optimizer
+ * @param opt Optimizer
+ * @param function Batch function in which is optimization done
+ * @param data Data passed to every call of the function (can be NULL)
+ * @param bounds Bounds of the function in which will be the function optimized
+ *               (n arrays of minimum and maximum)
+ * @param fitness Fitness functions that determinates if passed in value is better
+ *                than other passed in value
+ * @param result Result of the optimization is saved here (can be NULL), if its `best_pos` is not NULL,
+ *               the best position is copied into it, otherwise it is set to optimizer's storage,
+ *               which is valid until next run or destruction of the optimizer
+ */
+void pso_run_batch(TPSOOptimizer *opt, funcndim_batch function, void *data, double bounds[][2], fit_func fitness, TPSOResult *result);
+
+/**
+ * Runs asynchronous optimization with evaluations done by caller
+ * Positions are passed to `submit` and caller passes their values to pso_complete
+ * (from any thread and in any order). Each particle is updated as soon as its own
+ * value is known using the best position known at that time and it is submitted
+ * again. This keeps all evaluators busy when evaluation time varies.
+ * The run does max_iter evaluations for every particle on average, then waits for
+ * all submitted evaluations and returns. Diameter stopping criterion is not used.
+ * @param opt Optimizer
+ * @param submit Function submitting position for evaluation, it is always called
+ *               from the calling thread and it can call pso_complete itself
+ * @param data Data passed to every call of submit (can be NULL)
+ * @param bounds Bounds of the function in which will be the function optimized
+ *               (n arrays of minimum and maximum)
+ * @param fitness Fitness functions that determinates if passed in value is better
+ *                than other passed in value
+ * @param result Result of the optimization is saved here (can be NULL), see pso_run
+ */
+void pso_run_submit(TPSOOptimizer *opt, submit_func submit, void *data, double bounds[][2], fit_func fitness, TPSOResult *result);
+
+/**
+ * Passes value of submitted position to asynchronous run (see pso_run_submit)
+ * @param opt Optimizer
+ * @param particle Index of the particle passed to submit function
+ * @param value Function value at the submitted position
+ */
+void pso_complete(TPSOOptimizer *opt, unsigned int particle, double value);
+
+/**
+ * Destroys optimizer, stops its threads and frees its memory
+ * @param opt Optimizer
+ */
+void pso_destroy(TPSOOptimizer *opt);
+
+/**
+ * Particle swarm optimization algorithm for n dimensional functions using
+ * structure of arrays swarm storage
+ * The whole swarm is allocated in one aligned block of memory and every attribute
+ * is stored coordinate by coordinate for all particles, so updates go through
+ * memory linearly.
+ * @param function Function in which is optimization done
+ * @param bounds Bounds of the function in which will be the function optimized.
+ *               this should be n arrays (where n is the amount of dimensions of
+ *               the optimized function) of 2 values where the 1st one is the
+ *               minimum and second one is the maximum. E.g.: for `x in <0, 5> &
+ *               y in <-10, 10>` the bounds should be `{{0.0, 5.0}, {-10.0, 10.0}}`.
+ * @param dimensions The dimensions of optimized function.
+ *                   Dimensions means how many coordinates are there in the optimized
+ *                   function. E.g.: z = x^2 + y is 3 dimensional - it has 2 variables
+ *                   plus the result (3 dimensions).
+ * @param fitness Fitness functions that determinates if passed in value is better
+ *                than other passed in value
+ * @param particle_am The amount of particles to use for optimization (10 to 20 is
+ *                    usually good enough amount for most functions)
+ * @param max_iter The amount of iterations that should be done.
+ *                 More results in better precision but longer calculation.
+ * @return Array with n (n = dimensions - 1) doubles - the best found coordinates.
+ * @note psondim uses the same engine, this function is its alias
+ */
+double* psondim_soa(funcndim function, double bounds[][2], unsigned short dimensions, fit_func fitness, unsigned int particle_am, unsigned long max_iter);
+
+/**
+ * Particle swarm optimization algorithm for 3 dimensional functions using batch evaluation
+ * @param function Batch function in which is optimization done, it is called
+ *                 once per iteration for the whole swarm
+ * @param data Data passed to every call of the function (can be NULL)
+ * @param bounds Bounds of the function in which will be the function optimized.
+ *               this should be 2 arrays of 2 values where the 1st one is
+ *               the minimum and second one is the maximum. E.g.: for `x in <0, 5> &
+ *               y in <-10, 10>` the bounds should be `{{0.0, 5.0}, {-10.0, 10.0}}`.
+ * @param fitness Fitness functions that determinates if passed in value is better
+ *                than other passed in value
+ * @param particle_am The amount of particles to use for optimization (10 to 20 is
+ *                    usually good enough amount for most functions)
+ * @param max_iter The amount of iterations that should be done.
+ *                 More results in better precision but longer calculation.
+ * @return Array with 2 doubles - the best found x and y coordinates.
+ */
+double* pso3dim_batch(func3dim_batch function, void *data, double bounds[2][2], fit_func fitness, unsigned int particle_am, unsigned long max_iter);
+
+/**
+ * Particle swarm optimization algorithm for n dimensional functions using batch evaluation
+ * @param function Batch function in which is optimization done, it is called
+ *                 once per iteration for the whole swarm
+ * @param data Data passed to every call of the function (can be NULL)
+ * @param bounds Bounds of the function in which will be the function optimized.
+ *               this should be n arrays (where n is the amount of dimensions of
+ *               the optimized function) of 2 values where the 1st one is the
+ *               minimum and second one is the maximum. E.g.: for `x in <0, 5> &
+ *               y in <-10, 10>` the bounds should be `{{0.0, 5.0}, {-10.0, 10.0}}`.
+ * @param dimensions The dimensions of optimized function.
+ *                   Dimensions means how many coordinates are there in the optimized
+ *                   function. E.g.: z = x^2 + y is 3 dimensional - it has 2 variables
+ *                   plus the result (3 dimensions).
+ * @param fitness Fitness functions that determinates if passed in value is better
+ *                than other passed in value
+ * @param particle_am The amount of particles to use for optimization (10 to 20 is
+ *                    usually good enough amount for most functions)
+ * @param max_iter The amount of iterations that should be done.
+ *                 More results in better precision but longer calculation.
+ * @return Array with n (n = dimensions - 1) doubles - the best found coordinates.
+ * @note Batch function gets positions of the whole swarm in coordinate by coordinate layout
+ */
+double* psondim_batch(funcndim_batch function, void *data, double bounds[][2], unsigned short dimensions, fit_func fitness, unsigned int particle_am, unsigned long max_iter);
+
+/**
+ * Particle swarm optimization algorithm for n dimensional functions running in multiple threads
+ * Particles are split across threads in contiguous ranges, each thread evaluates and
+ * updates only its range and global best is reduced from best values found by each thread
+ * once per iteration.
+ * @param function Function in which is optimization done, it is called from multiple threads
+ *                 at once, so it has to be thread safe
+ * @param bounds Bounds of the function in which will be the function optimized.
+ *               this should be n arrays (where n is the amount of dimensions of
+ *               the optimized function) of 2 values where the 1st one is the
+ *               minimum and second one is the maximum. E.g.: for `x in <0, 5> &
+ *               y in <-10, 10>` the bounds should be `{{0.0, 5.0}, {-10.0, 10.0}}`.
+ * @param dimensions The dimensions of optimized function.
+ *                   Dimensions means how many coordinates are there in the optimized
+ *                   function. E.g.: z = x^2 + y is 3 dimensional - it has 2 variables
+ *                   plus the result (3 dimensions).
+ * @param fitness Fitness functions that determinates if passed in value is better
+ *                than other passed in value
+ * @param particle_am The amount of particles to use for optimization (10 to 20 is
+ *                    usually good enough amount for most functions)
+ * @param max_iter The amount of iterations that should be done.
+ *                 More results in better precision but longer calculation.
+ * @param threads The amount of threads to split particles across (0 means one thread per
+ *                online processor)
+ * @param seed Seed for pseudo-random generators
+ * @return Array with n (n = dimensions - 1) doubles - the best found coordinates.
+ * @note Result is deterministic for the same seed and amount of threads
+ */
+double* psondim_parallel(funcndim function, double bounds[][2], unsigned short dimensions, fit_func fitness, unsigned int particle_am, unsigned long max_iter, unsigned int threads, uint64_t seed);
+
 /**
  * Particle swarm optimization algorithm for 3 dimensional functions that does not use dynamical allocation
  * @param function Function in which is optimization done
@@ -153,4 +937,52 @@ TPSOxy pso3dim_static(func3dim function, double bounds[2][2], fit_func fitness,
  */
 TPSOxy pso3dim_static_opt(func3dim function, double bounds[2][2], fit_func fitness, unsigned long max_iter);
 
+/**
+ * Particle swarm optimization algorithm for 4 dimensional functions that does not use dynamical allocation
+ * Generated from pso_static.h (loops over coordinates are unrolled)
+ * @param function Function in which is optimization done
+ * @param bounds Bounds of the function in which will be the function optimized
+ *               (3 arrays of minimum and maximum)
+ * @param fitness Fitness functions that determinates if passed in value is better
+ *                than other passed in value
+ * @param max_iter The amount of iterations that should be done.
+ * @param rng Pseudo-random generator to be used (if NULL, it is seeded as for calls without explicit seed)
+ * @param best_pos The best found coordinates are written here
+ * @return The best found value
+ * @note The amount of particles is determinated by the value of `PSO3DIM_STATIC_PARTICLES` macro
+ */
+double pso4dim_static(funcndim function, double bounds[3][2], fit_func fitness, unsigned long max_iter, TPSORng *rng, double best_pos[3]);
+
+/**
+ * Particle swarm optimization algorithm for 6 dimensional functions that does not use dynamical allocation
+ * Generated from pso_static.h (loops over coordinates are unrolled)
+ * @param function Function in which is optimization done
+ * @param bounds Bounds of the function in which will be the function optimized
+ *               (5 arrays of minimum and maximum)
+ * @param fitness Fitness functions that determinates if passed in value is better
+ *                than other passed in value
+ * @param max_iter The amount of iterations that should be done.
+ * @param rng Pseudo-random generator to be used (if NULL, it is seeded as for calls without explicit seed)
+ * @param best_pos The best found coordinates are written here
+ * @return The best found value
+ * @note The amount of particles is determinated by the value of `PSO3DIM_STATIC_PARTICLES` macro
+ */
+double pso6dim_static(funcndim function, double bounds[5][2], fit_func fitness, unsigned long max_iter, TPSORng *rng, double best_pos[5]);
+
+/**
+ * Particle swarm optimization algorithm for 8 dimensional functions that does not use dynamical allocation
+ * Generated from pso_static.h (loops over coordinates are unrolled)
+ * @param function Function in which is optimization done
+ * @param bounds Bounds of the function in which will be the function optimized
+ *               (7 arrays of minimum and maximum)
+ * @param fitness Fitness functions that determinates if passed in value is better
+ *                than other passed in value
+ * @param max_iter The amount of iterations that should be done.
+ * @param rng Pseudo-random generator to be used (if NULL, it is seeded as for calls without explicit seed)
+ * @param best_pos The best found coordinates are written here
+ * @return The best found value
+ * @note The amount of particles is determinated by the value of `PSO3DIM_STATIC_PARTICLES` macro
+ */
+double pso8dim_static(funcndim function, double bounds[7][2], fit_func fitness, unsigned long max_iter, TPSORng *rng, double best_pos[7]);
+
 #endif //_PSO_H_
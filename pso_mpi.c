@@ -0,0 +1,190 @@
+/**
+ * @file pso_mpi.c
+ * @author Marek Sedláček
+ * @date October 2026
+ *
+ * @brief Source file for distributed evaluation of PSO module using MPI
+ *
+ * Every round rank 0 broadcasts the amount of positions, scatters them
+ * to all ranks and gathers their values. Negative amount ends serving
+ * and is followed by broadcast of the global best.
+ */
+#include "pso_mpi.h"
+#include <stdlib.h>
+
+#define MPI_FINISH (-1)  //< Amount of positions which ends serving
+
+/**
+ * Initializes distributed evaluator
+ * Has to be called by all ranks of the communicator
+ * @param mpi Evaluator
+ * @param comm Communicator (rank 0 runs optimization, other ranks serve evaluations)
+ * @param function Function evaluated by every rank
+ * @param dimensions The dimensions of optimized function (amount of coordinates plus 1)
+ * @return false if allocation failed
+ */
+bool pso_mpi_init(TPSOMpi *mpi, MPI_Comm comm, funcndim function, unsigned short dimensions){
+    mpi->comm = comm;
+    mpi->function = function;
+    mpi->coords = dimensions - 1;
+    MPI_Comm_rank(comm, &(mpi->rank));
+    MPI_Comm_size(comm, &(mpi->size));
+    mpi->buffer = NULL;
+    mpi->capacity = 0;
+    // Counts and offsets for positions and for values are in one block
+    mpi->counts = malloc(sizeof(int) * 4 * mpi->size);
+#ifdef ASSERT_ALLOCATION
+    if(!mpi->counts){
+        error_handler();
+    }
+#endif // ASSERT_ALLOCATION
+    mpi->displs = mpi->counts ? mpi->counts + 2 * mpi->size : NULL;
+    return mpi->counts != NULL;
+}
+
+/**
+ * Makes sure that buffer has space for positions and values
+ * @param mpi Evaluator
+ * @param amount The amount of positions
+ */
+static void reserve(TPSOMpi *mpi, size_t amount){
+    if(amount <= mpi->capacity){
+        return;
+    }
+    double *buffer = realloc(mpi->buffer, sizeof(double) * amount * (mpi->coords + 1));
+#ifdef ASSERT_ALLOCATION
+    if(!buffer){
+        error_handler();
+    }
+#endif // ASSERT_ALLOCATION
+    if(!buffer){
+        // Other ranks are in collective calls already
+        MPI_Abort(mpi->comm, 1);
+    }
+    mpi->buffer = buffer;
+    mpi->capacity = amount;
+}
+
+/**
+ * Splits positions between ranks
+ * Every rank gets contiguous part of positions of almost the same size
+ * @param mpi Evaluator
+ * @param amount The amount of positions
+ */
+static void plan_parts(TPSOMpi *mpi, int amount){
+    int size = mpi->size;
+    for(int r = 0; r < size; r++){
+        int begin = (int)((long long)amount * r / size);
+        int end = (int)((long long)amount * (r + 1) / size);
+        // Positions
+        mpi->counts[r] = (end - begin) * mpi->coords;
+        mpi->displs[r] = begin * mpi->coords;
+        // Values
+        mpi->counts[size + r] = end - begin;
+        mpi->displs[size + r] = begin;
+    }
+}
+
+/**
+ * Evaluates positions in buffer
+ * @param mpi Evaluator
+ * @param positions Positions (coordinates of each position next to each other)
+ * @param amount The amount of positions
+ * @param values Array for values
+ */
+static void evaluate(TPSOMpi *mpi, double *positions, int amount, double *values){
+    for(int a = 0; a < amount; a++){
+        values[a] = mpi->function(&(positions[(size_t)a * mpi->coords]));
+    }
+}
+
+/**
+ * Batch function evaluating positions on all ranks (called on rank 0, see funcndim_batch)
+ * @param positions Matrix of positions stored coordinate by coordinate
+ * @param stride Length of a matrix row
+ * @param coords Amount of coordinates
+ * @param amount Amount of positions
+ * @param values Array into which values are written
+ * @param data Distributed evaluator (TPSOMpi *)
+ */
+void pso_mpi_batch(const double *positions, size_t stride, unsigned short coords, unsigned int amount, double *values, void *data){
+    TPSOMpi *mpi = data;
+    int header = (int)amount;
+    MPI_Bcast(&header, 1, MPI_INT, 0, mpi->comm);
+    reserve(mpi, amount);
+    // Positions are sent one after another, so that every rank can pass them to the function
+    for(unsigned int a = 0; a < amount; a++){
+        for(unsigned short c = 0; c < coords; c++){
+            mpi->buffer[(size_t)a * coords + c] = positions[c*stride + a];
+        }
+    }
+    plan_parts(mpi, header);
+    int size = mpi->size;
+    // Part of rank 0 stays at the start of the buffer and its values are written right into values
+    MPI_Scatterv(mpi->buffer, mpi->counts, mpi->displs, MPI_DOUBLE, MPI_IN_PLACE, mpi->counts[0], MPI_DOUBLE, 0, mpi->comm);
+    evaluate(mpi, mpi->buffer, mpi->counts[size], values);
+    MPI_Gatherv(MPI_IN_PLACE, 0, MPI_DOUBLE, values, &(mpi->counts[size]), &(mpi->displs[size]), MPI_DOUBLE, 0, mpi->comm);
+}
+
+/**
+ * Serves evaluations on ranks other than 0 until rank 0 calls pso_mpi_finish
+ * @param mpi Evaluator
+ * @param best_pos Array for the best position broadcast by rank 0 (can be NULL)
+ * @param best_value The best value broadcast by rank 0 is saved here (can be NULL)
+ */
+void pso_mpi_serve(TPSOMpi *mpi, double *best_pos, double *best_value){
+    int size = mpi->size;
+    while(true){
+        int header;
+        MPI_Bcast(&header, 1, MPI_INT, 0, mpi->comm);
+        if(header == MPI_FINISH){
+            break;
+        }
+        plan_parts(mpi, header);
+        int amount = mpi->counts[size + mpi->rank];
+        reserve(mpi, amount);
+        double *values = mpi->buffer + (size_t)amount * mpi->coords;
+        MPI_Scatterv(NULL, NULL, NULL, MPI_DOUBLE, mpi->buffer, mpi->counts[mpi->rank], MPI_DOUBLE, 0, mpi->comm);
+        evaluate(mpi, mpi->buffer, amount, values);
+        MPI_Gatherv(values, amount, MPI_DOUBLE, NULL, NULL, NULL, MPI_DOUBLE, 0, mpi->comm);
+    }
+    // The global best is sent as its coordinates followed by its value
+    reserve(mpi, 1);
+    MPI_Bcast(mpi->buffer, mpi->coords + 1, MPI_DOUBLE, 0, mpi->comm);
+    for(unsigned short c = 0; best_pos && c < mpi->coords; c++){
+        best_pos[c] = mpi->buffer[c];
+    }
+    if(best_value){
+        *best_value = mpi->buffer[mpi->coords];
+    }
+}
+
+/**
+ * Ends serving on all other ranks and broadcasts the global best to them (called on rank 0)
+ * @param mpi Evaluator
+ * @param best_pos The best position
+ * @param best_value The best value
+ */
+void pso_mpi_finish(TPSOMpi *mpi, const double *best_pos, double best_value){
+    int header = MPI_FINISH;
+    MPI_Bcast(&header, 1, MPI_INT, 0, mpi->comm);
+    reserve(mpi, 1);
+    for(unsigned short c = 0; c < mpi->coords; c++){
+        mpi->buffer[c] = best_pos[c];
+    }
+    mpi->buffer[mpi->coords] = best_value;
+    MPI_Bcast(mpi->buffer, mpi->coords + 1, MPI_DOUBLE, 0, mpi->comm);
+}
+
+/**
+ * Frees buffers of distributed evaluator
+ * @param mpi Evaluator
+ */
+void pso_mpi_free(TPSOMpi *mpi){
+    free(mpi->buffer);
+    free(mpi->counts);
+    mpi->buffer = NULL;
+    mpi->counts = NULL;
+    mpi->displs = NULL;
+    mpi->capacity = 0;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file pso_mpi.h
+ * @author Marek Sedláček
+ * @date October 2026
+ *
+ * @brief Header file for distributed evaluation of PSO module using MPI
+ *
+ * Swarm is optimized by rank 0 using batch evaluation (see funcndim_batch),
+ * batch function pso_mpi_batch scatters positions of the swarm to all ranks,
+ * every rank evaluates its part and values are gathered back to rank 0.
+ * Other ranks only serve evaluations in pso_mpi_serve. Positions are sent as
+ * plain doubles, so one round moves N*D doubles to ranks and N values back.
+ *
+ * Usage (every rank runs the same program):
+ *
+ *     TPSOMpi mpi;
+ *     pso_mpi_init(&mpi, MPI_COMM_WORLD, function, dimensions);
+ *     if(rank == 0){
+ *         psondim_batch_config(pso_mpi_batch, &mpi, bounds, dimensions, fitness, &config, &result);
+ *         pso_mpi_finish(&mpi, result.best_pos, result.best_value);
+ *     }
+ *     else{
+ *         pso_mpi_serve(&mpi, best_pos, &best_value);
+ *     }
+ *     pso_mpi_free(&mpi);
+ *
+ * Batch function does MPI calls, so it has to be called by one thread
+ * (configuration with 1 thread) unless MPI supports MPI_THREAD_MULTIPLE
+ * and every thread has its own TPSOMpi with its own communicator.
+ *
+ * Ranks cannot continue collective communication when a buffer cannot
+ * be grown, so allocation failure during evaluation aborts all ranks.
+ *
+ * This module is compiled only by `make mpi` (it needs MPI compiler wrapper).
+ */
+
+#ifndef _PSO_MPI_H_
+#define _PSO_MPI_H_
+
+#include "pso.h"
+#include <mpi.h>
+
+/**
+ * Distributed evaluator
+ */
+typedef struct {
+    MPI_Comm comm;          //< Communicator of all ranks (rank 0 runs optimization)
+    funcndim function;      //< Function evaluated by every rank (rank 0 evaluates its part too)
+    unsigned short coords;  //< How many coordinates positions have (dimensions - 1)
+    int rank;               //< Rank of this process
+    int size;               //< The amount of ranks
+    double *buffer;         //< Positions (coordinates of each position next to each other) followed by values
+    size_t capacity;        //< The amount of positions buffer has space for
+    int *counts;            //< The amount of doubles for each rank (positions, then values)
+    int *displs;            //< Offset of doubles of each rank (positions, then values)
+} TPSOMpi;
+
+/**
+ * Initializes distributed evaluator
+ * Has to be called by all ranks of the communicator
+ * @param mpi Evaluator
+ * @param comm Communicator (rank 0 runs optimization, other ranks serve evaluations)
+ * @param function Function evaluated by every rank
+ * @param dimensions The dimensions of optimized function (amount of coordinates plus 1)
+ * @return false if allocation failed
+ */
+bool pso_mpi_init(TPSOMpi *mpi, MPI_Comm comm, funcndim function, unsigned short dimensions);
+
+/**
+ * Batch function evaluating positions on all ranks (called on rank 0, see funcndim_batch)
+ * @param positions Matrix of positions stored coordinate by coordinate
+ * @param stride Length of a matrix row
+ * @param coords Amount of coordinates
+ * @param amount Amount of positions
+ * @param values Array into which values are written
+ * @param data Distributed evaluator (TPSOMpi *)
+ */
+void pso_mpi_batch(const double *positions, size_t stride, unsigned short coords, unsigned int amount, double *values, void *data);
+
+/**
+ * Serves evaluations on ranks other than 0 until rank 0 calls pso_mpi_finish
+ * @param mpi Evaluator
+ * @param best_pos Array for the best position broadcast by rank 0 (can be NULL)
+ * @param best_value The best value broadcast by rank 0 is saved here (can be NULL)
+ */
+void pso_mpi_serve(TPSOMpi *mpi, double *best_pos, double *best_value);
+
+/**
+ * Ends serving on all other ranks and broadcasts the global best to them (called on rank 0)
+ * @param mpi Evaluator
+ * @param best_pos The best position
+ * @param best_value The best value
+ */
+void pso_mpi_finish(TPSOMpi *mpi, const double *best_pos, double best_value);
+
+/**
+ * Frees buffers of distributed evaluator
+ * @param mpi Evaluator
+ */
+void pso_mpi_free(TPSOMpi *mpi);
+
+#endif //_PSO_MPI_H_
@@ -0,0 +1,1286 @@
+/**
+ * @file pso_simd.c
+ * @author Marek Sedláček
+ * @date October 2026
+ *
+ * @brief Source file for vectorized parts of PSO module
+ *
+ * This file contains functions processing whole rows of the
+ * structure of arrays swarm. Every function has plain C
+ * implementation and implementations using SSE2, AVX2 and
+ * AVX-512 (on x86) or NEON (on aarch64). The best supported
+ * one is chosen at runtime, unless it is set by pso_set_isa.
+ *
+ * All implementations do the same floating point operations in
+ * the same order (FMA is not used), so results do not depend
+ * on which instruction set is used.
+ */
+
+#include "pso_simd.h"
+#include <string.h>
+#include <stdatomic.h>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_X86  //< SSE2, AVX2 and AVX-512 implementations are compiled
+#include <immintrin.h>
+#define TARGET_SSE2 __attribute__((target("sse2")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#define TARGET_AVX512 __attribute__((target("avx512f")))
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define SIMD_NEON  //< NEON implementations are compiled
+#include <arm_neon.h>
+#endif
+
+// Multiplication and addition must not be contracted into FMA (GNU dialects and
+//  targets with FMA allow it), otherwise AVX-512 and scalar results would differ
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+#define DOUBLE_ONE_BITS 0x3FF0000000000000ULL  //< Bit representation of 1.0
+#define FLOAT_ONE_BITS 0x3F800000u  //< Bit representation of 1.0f
+
+/**
+ * Implementations for one instruction set
+ */
+typedef struct {
+    void (* rng_fill)(TRngLanes *, double *, size_t);  //< Generates given amount of values in all lanes
+    void (* row_update)(double *, double *, const double *, const double *, const double *, const double *, const double *, size_t, const TRowUpdate *);  //< Updates row of particles
+    void (* rng_fill_float)(TRngLanes *, float *, size_t);  //< Generates given amount of single precision values in all lanes
+    void (* row_update_float)(float *, float *, const float *, const float *, const float *, const float *, const float *, size_t, const TRowUpdate *);  //< Updates row of single precision particles
+    uint64_t (* row_compare)(const double *, double, size_t, uint64_t *);  //< Compares row of values with one value
+} TSimdKernels;
+
+static _Atomic int active_isa = -1;  //< Used instruction set (-1 if it was not chosen yet)
+
+/**
+ * Seeds all lanes using generator
+ * Each lane gets its seed from the generator and expands it using splitmix64
+ * @param lanes Lanes to seed
+ * @param rng Generator used for seeding
+ */
+void rng_lanes_seed(TRngLanes *lanes, TPSORng *rng){
+    for(int l = 0; l < RNG_LANES; l++){
+        TPSORng lane;
+        pso_rng_seed(&lane, pso_rng_next(rng));
+        for(int w = 0; w < 4; w++){
+            lanes->s[w][l] = lane.s[w];
+        }
+    }
+}
+
+/**
+ * Generates one value in all lanes using plain C
+ * Loops over lanes have no dependencies, so compiler can vectorize them
+ * @param g Generator lanes
+ * @param out Array for RNG_LANES doubles
+ */
+static inline void lanes_step_scalar(TRngLanes *g, double *out){
+    uint64_t *s0 = g->s[0], *s1 = g->s[1], *s2 = g->s[2], *s3 = g->s[3];
+    for(int l = 0; l < RNG_LANES; l++){
+        uint64_t x = s1[l] * 5;
+        x = ((x << 7) | (x >> 57)) * 9;
+        uint64_t t = s1[l] << 17;
+        s2[l] ^= s0[l];
+        s3[l] ^= s1[l];
+        s1[l] ^= s2[l];
+        s0[l] ^= s3[l];
+        s2[l] ^= t;
+        s3[l] = (s3[l] << 45) | (s3[l] >> 19);
+        // Upper 52 bits are put into mantissa of a number in <1, 2)
+        uint64_t bits = (x >> 12) | DOUBLE_ONE_BITS;
+        double d;
+        memcpy(&d, &bits, sizeof(d));
+        out[l] = d - 1.0;
+    }
+}
+
+/**
+ * Generates values in all lanes using plain C
+ * @param g Generator lanes
+ * @param out Array to be filled
+ * @param steps How many values should every lane generate
+ */
+static void rng_fill_scalar(TRngLanes *g, double *out, size_t steps){
+    for(size_t i = 0; i < steps; i++){
+        lanes_step_scalar(g, out + i*RNG_LANES);
+    }
+}
+
+/**
+ * Generates one single precision value in all lanes using plain C
+ * Generators are advanced the same way as by lanes_step_scalar
+ * @param g Generator lanes
+ * @param out Array for RNG_LANES floats
+ */
+static inline void lanes_step_float_scalar(TRngLanes *g, float *out){
+    uint64_t *s0 = g->s[0], *s1 = g->s[1], *s2 = g->s[2], *s3 = g->s[3];
+    for(int l = 0; l < RNG_LANES; l++){
+        uint64_t x = s1[l] * 5;
+        x = ((x << 7) | (x >> 57)) * 9;
+        uint64_t t = s1[l] << 17;
+        s2[l] ^= s0[l];
+        s3[l] ^= s1[l];
+        s1[l] ^= s2[l];
+        s0[l] ^= s3[l];
+        s2[l] ^= t;
+        s3[l] = (s3[l] << 45) | (s3[l] >> 19);
+        // Upper 23 bits are put into mantissa of a number in <1, 2)
+        uint32_t bits = (uint32_t)(x >> 41) | FLOAT_ONE_BITS;
+        float f;
+        memcpy(&f, &bits, sizeof(f));
+        out[l] = f - 1.0f;
+    }
+}
+
+/**
+ * Generates single precision values in all lanes using plain C
+ * @param g Generator lanes
+ * @param out Array to be filled
+ * @param steps How many values should every lane generate
+ */
+static void rng_fill_float_scalar(TRngLanes *g, float *out, size_t steps){
+    for(size_t i = 0; i < steps; i++){
+        lanes_step_float_scalar(g, out + i*RNG_LANES);
+    }
+}
+
+/**
+ * Updates one particle coordinate
+ * This is the reference computation, vectorized kernels do the same operations in the same order
+ */
+static inline void update_one(double *velocity, double *position, double rand_p, double rand_g, double personal, double social, const double *rand_r, const TRowUpdate *prm){
+    double cog_diff = personal - *position;
+    double pos_diff = social - *position;
+    double v = prm->w * *velocity + prm->cp * rand_p * cog_diff + prm->cg * rand_g * pos_diff;
+    // Branchless velocity limit and clamping (compiles to min/max instructions)
+    v = v > -prm->vmax ? v : -prm->vmax;
+    v = v < prm->vmax ? v : prm->vmax;
+    double x = *position + v;
+    double xc = x > prm->min ? x : prm->min;
+    xc = xc < prm->max ? xc : prm->max;
+    bool out = xc != x;
+    if(prm->reflect){
+        // Clamped position is on the crossed bound, so this mirrors the position at it
+        double xr = xc + xc - x;
+        xr = xr > prm->min ? xr : prm->min;
+        xr = xr < prm->max ? xr : prm->max;
+        xc = out ? xr : xc;
+    }
+    if(rand_r){
+        xc = out ? prm->min + *rand_r * (prm->max - prm->min) : xc;
+    }
+    *velocity = out ? v * prm->bounce : v;
+    *position = xc;
+}
+
+/**
+ * Updates row of particles using plain C
+ * @param velocity Row of velocities
+ * @param position Row of positions
+ * @param rand_p Cognitive random numbers
+ * @param rand_g Social random numbers
+ * @param personal Row of personal best coordinates (NULL if social attractor is used instead)
+ * @param social Row of social attractors (NULL if all particles use prm->social)
+ * @param rand_r Random numbers for positions of particles which crossed bounds (NULL if they are not reinitialized)
+ * @param n Amount of particles in the row
+ * @param prm Update parameters
+ */
+static void row_update_scalar(double *velocity, double *position, const double *rand_p, const double *rand_g, const double *personal, const double *social, const double *rand_r, size_t n, const TRowUpdate *prm){
+    for(size_t a = 0; a < n; a++){
+        double g = social ? social[a] : prm->social;
+        update_one(&(velocity[a]), &(position[a]), rand_p[a], rand_g[a], personal ? personal[a] : g, g, rand_r ? &(rand_r[a]) : NULL, prm);
+    }
+}
+
+/**
+ * Updates one single precision particle coordinate
+ * This is the reference computation, vectorized kernels do the same operations in the same order
+ */
+static inline void update_one_float(float *velocity, float *position, float rand_p, float rand_g, float personal, float social, const float *rand_r, const TRowUpdate *prm){
+    float w = (float)prm->w, cp = (float)prm->cp, cg = (float)prm->cg;
+    float min = (float)prm->min, max = (float)prm->max, vmax = (float)prm->vmax;
+    float cog_diff = personal - *position;
+    float pos_diff = social - *position;
+    float v = w * *velocity + cp * rand_p * cog_diff + cg * rand_g * pos_diff;
+    v = v > -vmax ? v : -vmax;
+    v = v < vmax ? v : vmax;
+    float x = *position + v;
+    float xc = x > min ? x : min;
+    xc = xc < max ? xc : max;
+    bool out = xc != x;
+    if(prm->reflect){
+        float xr = xc + xc - x;
+        xr = xr > min ? xr : min;
+        xr = xr < max ? xr : max;
+        xc = out ? xr : xc;
+    }
+    if(rand_r){
+        xc = out ? min + *rand_r * (max - min) : xc;
+    }
+    *velocity = out ? v * (float)prm->bounce : v;
+    *position = xc;
+}
+
+/**
+ * Updates row of single precision particles using plain C
+ * @param velocity Row of velocities
+ * @param position Row of positions
+ * @param rand_p Cognitive random numbers
+ * @param rand_g Social random numbers
+ * @param personal Row of personal best coordinates (NULL if social attractor is used instead)
+ * @param social Row of social attractors (NULL if all particles use prm->social)
+ * @param rand_r Random numbers for positions of particles which crossed bounds (NULL if they are not reinitialized)
+ * @param n Amount of particles in the row
+ * @param prm Update parameters (rounded to single precision)
+ */
+static void row_update_float_scalar(float *velocity, float *position, const float *rand_p, const float *rand_g, const float *personal, const float *social, const float *rand_r, size_t n, const TRowUpdate *prm){
+    float gbest = (float)prm->social;
+    for(size_t a = 0; a < n; a++){
+        float g = social ? social[a] : gbest;
+        update_one_float(&(velocity[a]), &(position[a]), rand_p[a], rand_g[a], personal ? personal[a] : g, g, rand_r ? &(rand_r[a]) : NULL, prm);
+    }
+}
+
+/**
+ * Compares row of values with one value
+ * @param row Row of values
+ * @param x Compared value
+ * @param n Amount of values in the row
+ * @param flags Bit 0 is set in flags of values lower than x and bit 1 in flags of values greater than x
+ * @return Bitwise and of all updated flags
+ */
+static uint64_t row_compare_scalar(const double *row, double x, size_t n, uint64_t *flags){
+    uint64_t all = ~(uint64_t)0;
+    for(size_t j = 0; j < n; j++){
+        flags[j] |= (uint64_t)(row[j] < x) | ((uint64_t)(x < row[j]) << 1);
+        all &= flags[j];
+    }
+    return all;
+}
+
+#ifdef SIMD_X86
+/**
+ * Generates values in all lanes using SSE2
+ * @param g Generator lanes
+ * @param out Array to be filled
+ * @param steps How many values should every lane generate
+ */
+TARGET_SSE2 static void rng_fill_sse2(TRngLanes *g, double *out, size_t steps){
+    __m128i s[4][RNG_LANES/2];
+    for(int w = 0; w < 4; w++){
+        for(int h = 0; h < RNG_LANES/2; h++){
+            s[w][h] = _mm_load_si128((const __m128i *)&(g->s[w][h*2]));
+        }
+    }
+    const __m128i one = _mm_set1_epi64x((long long)DOUBLE_ONE_BITS);
+    const __m128d done = _mm_set1_pd(1.0);
+    for(size_t i = 0; i < steps; i++){
+        for(int h = 0; h < RNG_LANES/2; h++){
+            // Multiplications by 5 and 9 are done as shift and add
+            __m128i x = _mm_add_epi64(s[1][h], _mm_slli_epi64(s[1][h], 2));
+            x = _mm_or_si128(_mm_slli_epi64(x, 7), _mm_srli_epi64(x, 57));
+            x = _mm_add_epi64(x, _mm_slli_epi64(x, 3));
+            __m128i t = _mm_slli_epi64(s[1][h], 17);
+            s[2][h] = _mm_xor_si128(s[2][h], s[0][h]);
+            s[3][h] = _mm_xor_si128(s[3][h], s[1][h]);
+            s[1][h] = _mm_xor_si128(s[1][h], s[2][h]);
+            s[0][h] = _mm_xor_si128(s[0][h], s[3][h]);
+            s[2][h] = _mm_xor_si128(s[2][h], t);
+            s[3][h] = _mm_or_si128(_mm_slli_epi64(s[3][h], 45), _mm_srli_epi64(s[3][h], 19));
+            __m128d d = _mm_castsi128_pd(_mm_or_si128(_mm_srli_epi64(x, 12), one));
+            _mm_storeu_pd(out + i*RNG_LANES + h*2, _mm_sub_pd(d, done));
+        }
+    }
+    for(int w = 0; w < 4; w++){
+        for(int h = 0; h < RNG_LANES/2; h++){
+            _mm_store_si128((__m128i *)&(g->s[w][h*2]), s[w][h]);
+        }
+    }
+}
+
+/**
+ * Updates row of particles using SSE2
+ * @param velocity Row of velocities
+ * @param position Row of positions
+ * @param rand_p Cognitive random numbers
+ * @param rand_g Social random numbers
+ * @param personal Row of personal best coordinates (NULL if social attractor is used instead)
+ * @param social Row of social attractors (NULL if all particles use prm->social)
+ * @param rand_r Random numbers for positions of particles which crossed bounds (NULL if they are not reinitialized)
+ * @param n Amount of particles in the row
+ * @param prm Update parameters
+ */
+TARGET_SSE2 static void row_update_sse2(double *velocity, double *position, const double *rand_p, const double *rand_g, const double *personal, const double *social, const double *rand_r, size_t n, const TRowUpdate *prm){
+    const __m128d w = _mm_set1_pd(prm->w);
+    const __m128d cp = _mm_set1_pd(prm->cp);
+    const __m128d cg = _mm_set1_pd(prm->cg);
+    const __m128d gbest = _mm_set1_pd(prm->social);
+    const __m128d min = _mm_set1_pd(prm->min);
+    const __m128d max = _mm_set1_pd(prm->max);
+    const __m128d range = _mm_set1_pd(prm->max - prm->min);
+    const __m128d vmax = _mm_set1_pd(prm->vmax);
+    const __m128d nvmax = _mm_set1_pd(-prm->vmax);
+    const __m128d bounce = _mm_set1_pd(prm->bounce);
+    size_t a = 0;
+    for(; a + 2 <= n; a += 2){
+        __m128d x = _mm_loadu_pd(position + a);
+        // Choice is the same for whole row, so the branch is always predicted
+        __m128d g = social ? _mm_loadu_pd(social + a) : gbest;
+        __m128d p = personal ? _mm_loadu_pd(personal + a) : g;
+        __m128d dp = _mm_sub_pd(p, x);
+        __m128d d = _mm_sub_pd(g, x);
+        __m128d v = _mm_mul_pd(w, _mm_loadu_pd(velocity + a));
+        v = _mm_add_pd(v, _mm_mul_pd(_mm_mul_pd(cp, _mm_loadu_pd(rand_p + a)), dp));
+        v = _mm_add_pd(v, _mm_mul_pd(_mm_mul_pd(cg, _mm_loadu_pd(rand_g + a)), d));
+        v = _mm_min_pd(_mm_max_pd(v, nvmax), vmax);
+        x = _mm_add_pd(x, v);
+        __m128d xc = _mm_min_pd(_mm_max_pd(x, min), max);
+        // SSE2 has no blend, selection is done by masks
+        __m128d out = _mm_cmpneq_pd(xc, x);
+        if(prm->reflect){
+            __m128d xr = _mm_sub_pd(_mm_add_pd(xc, xc), x);
+            xr = _mm_min_pd(_mm_max_pd(xr, min), max);
+            xc = _mm_or_pd(_mm_and_pd(out, xr), _mm_andnot_pd(out, xc));
+        }
+        if(rand_r){
+            __m128d xn = _mm_add_pd(min, _mm_mul_pd(_mm_loadu_pd(rand_r + a), range));
+            xc = _mm_or_pd(_mm_and_pd(out, xn), _mm_andnot_pd(out, xc));
+        }
+        v = _mm_or_pd(_mm_and_pd(out, _mm_mul_pd(v, bounce)), _mm_andnot_pd(out, v));
+        _mm_storeu_pd(velocity + a, v);
+        _mm_storeu_pd(position + a, xc);
+    }
+    row_update_scalar(velocity + a, position + a, rand_p + a, rand_g + a, personal ? personal + a : NULL, social ? social + a : NULL,
+                      rand_r ? rand_r + a : NULL, n - a, prm);
+}
+
+/**
+ * Generates single precision values in all lanes using SSE2
+ * @param g Generator lanes
+ * @param out Array to be filled
+ * @param steps How many values should every lane generate
+ */
+TARGET_SSE2 static void rng_fill_float_sse2(TRngLanes *g, float *out, size_t steps){
+    __m128i s[4][RNG_LANES/2];
+    for(int w = 0; w < 4; w++){
+        for(int h = 0; h < RNG_LANES/2; h++){
+            s[w][h] = _mm_load_si128((const __m128i *)&(g->s[w][h*2]));
+        }
+    }
+    const __m128i one = _mm_set1_epi64x(FLOAT_ONE_BITS);
+    const __m128 fone = _mm_set1_ps(1.0f);
+    for(size_t i = 0; i < steps; i++){
+        __m128i bits[RNG_LANES/2];
+        for(int h = 0; h < RNG_LANES/2; h++){
+            __m128i x = _mm_add_epi64(s[1][h], _mm_slli_epi64(s[1][h], 2));
+            x = _mm_or_si128(_mm_slli_epi64(x, 7), _mm_srli_epi64(x, 57));
+            x = _mm_add_epi64(x, _mm_slli_epi64(x, 3));
+            __m128i t = _mm_slli_epi64(s[1][h], 17);
+            s[2][h] = _mm_xor_si128(s[2][h], s[0][h]);
+            s[3][h] = _mm_xor_si128(s[3][h], s[1][h]);
+            s[1][h] = _mm_xor_si128(s[1][h], s[2][h]);
+            s[0][h] = _mm_xor_si128(s[0][h], s[3][h]);
+            s[2][h] = _mm_xor_si128(s[2][h], t);
+            s[3][h] = _mm_or_si128(_mm_slli_epi64(s[3][h], 45), _mm_srli_epi64(s[3][h], 19));
+            // Float bits are in the lower half of each 64 bit lane
+            bits[h] = _mm_or_si128(_mm_srli_epi64(x, 41), one);
+        }
+        for(int h = 0; h < RNG_LANES/2; h += 2){
+            __m128 f = _mm_shuffle_ps(_mm_castsi128_ps(bits[h]), _mm_castsi128_ps(bits[h + 1]), _MM_SHUFFLE(2, 0, 2, 0));
+            _mm_storeu_ps(out + i*RNG_LANES + h*2, _mm_sub_ps(f, fone));
+        }
+    }
+    for(int w = 0; w < 4; w++){
+        for(int h = 0; h < RNG_LANES/2; h++){
+            _mm_store_si128((__m128i *)&(g->s[w][h*2]), s[w][h]);
+        }
+    }
+}
+
+/**
+ * Updates row of single precision particles using SSE2
+ * @param velocity Row of velocities
+ * @param position Row of positions
+ * @param rand_p Cognitive random numbers
+ * @param rand_g Social random numbers
+ * @param personal Row of personal best coordinates (NULL if social attractor is used instead)
+ * @param social Row of social attractors (NULL if all particles use prm->social)
+ * @param rand_r Random numbers for positions of particles which crossed bounds (NULL if they are not reinitialized)
+ * @param n Amount of particles in the row
+ * @param prm Update parameters (rounded to single precision)
+ */
+TARGET_SSE2 static void row_update_float_sse2(float *velocity, float *position, const float *rand_p, const float *rand_g, const float *personal, const float *social, const float *rand_r, size_t n, const TRowUpdate *prm){
+    const __m128 w = _mm_set1_ps((float)prm->w);
+    const __m128 cp = _mm_set1_ps((float)prm->cp);
+    const __m128 cg = _mm_set1_ps((float)prm->cg);
+    const __m128 gbest = _mm_set1_ps((float)prm->social);
+    const __m128 min = _mm_set1_ps((float)prm->min);
+    const __m128 max = _mm_set1_ps((float)prm->max);
+    const __m128 range = _mm_set1_ps((float)prm->max - (float)prm->min);
+    const __m128 vmax = _mm_set1_ps((float)prm->vmax);
+    const __m128 nvmax = _mm_set1_ps(-(float)prm->vmax);
+    const __m128 bounce = _mm_set1_ps((float)prm->bounce);
+    size_t a = 0;
+    for(; a + 4 <= n; a += 4){
+        __m128 x = _mm_loadu_ps(position + a);
+        __m128 g = social ? _mm_loadu_ps(social + a) : gbest;
+        __m128 p = personal ? _mm_loadu_ps(personal + a) : g;
+        __m128 dp = _mm_sub_ps(p, x);
+        __m128 d = _mm_sub_ps(g, x);
+        __m128 v = _mm_mul_ps(w, _mm_loadu_ps(velocity + a));
+        v = _mm_add_ps(v, _mm_mul_ps(_mm_mul_ps(cp, _mm_loadu_ps(rand_p + a)), dp));
+        v = _mm_add_ps(v, _mm_mul_ps(_mm_mul_ps(cg, _mm_loadu_ps(rand_g + a)), d));
+        v = _mm_min_ps(_mm_max_ps(v, nvmax), vmax);
+        x = _mm_add_ps(x, v);
+        __m128 xc = _mm_min_ps(_mm_max_ps(x, min), max);
+        __m128 out = _mm_cmpneq_ps(xc, x);
+        if(prm->reflect){
+            __m128 xr = _mm_sub_ps(_mm_add_ps(xc, xc), x);
+            xr = _mm_min_ps(_mm_max_ps(xr, min), max);
+            xc = _mm_or_ps(_mm_and_ps(out, xr), _mm_andnot_ps(out, xc));
+        }
+        if(rand_r){
+            __m128 xn = _mm_add_ps(min, _mm_mul_ps(_mm_loadu_ps(rand_r + a), range));
+            xc = _mm_or_ps(_mm_and_ps(out, xn), _mm_andnot_ps(out, xc));
+        }
+        v = _mm_or_ps(_mm_and_ps(out, _mm_mul_ps(v, bounce)), _mm_andnot_ps(out, v));
+        _mm_storeu_ps(velocity + a, v);
+        _mm_storeu_ps(position + a, xc);
+    }
+    row_update_float_scalar(velocity + a, position + a, rand_p + a, rand_g + a, personal ? personal + a : NULL, social ? social + a : NULL,
+                            rand_r ? rand_r + a : NULL, n - a, prm);
+}
+
+/**
+ * Compares row of values with one value using SSE2 (see row_compare_scalar)
+ */
+TARGET_SSE2 static uint64_t row_compare_sse2(const double *row, double x, size_t n, uint64_t *flags){
+    const __m128d vx = _mm_set1_pd(x);
+    const __m128i one = _mm_set1_epi64x(1);
+    const __m128i two = _mm_set1_epi64x(2);
+    __m128i all = _mm_set1_epi64x(-1);
+    size_t j = 0;
+    for(; j + 2 <= n; j += 2){
+        __m128d r = _mm_loadu_pd(row + j);
+        __m128i lt = _mm_and_si128(_mm_castpd_si128(_mm_cmplt_pd(r, vx)), one);
+        __m128i gt = _mm_and_si128(_mm_castpd_si128(_mm_cmplt_pd(vx, r)), two);
+        __m128i f = _mm_or_si128(_mm_loadu_si128((const __m128i *)(flags + j)), _mm_or_si128(lt, gt));
+        _mm_storeu_si128((__m128i *)(flags + j), f);
+        all = _mm_and_si128(all, f);
+    }
+    uint64_t lanes[2];
+    _mm_storeu_si128((__m128i *)lanes, all);
+    return lanes[0] & lanes[1] & row_compare_scalar(row + j, x, n - j, flags + j);
+}
+
+/**
+ * Generates values in all lanes using AVX2
+ * @param g Generator lanes
+ * @param out Array to be filled
+ * @param steps How many values should every lane generate
+ */
+TARGET_AVX2 static void rng_fill_avx2(TRngLanes *g, double *out, size_t steps){
+    __m256i s[4][RNG_LANES/4];
+    for(int w = 0; w < 4; w++){
+        for(int h = 0; h < RNG_LANES/4; h++){
+            s[w][h] = _mm256_load_si256((const __m256i *)&(g->s[w][h*4]));
+        }
+    }
+    const __m256i one = _mm256_set1_epi64x((long long)DOUBLE_ONE_BITS);
+    const __m256d done = _mm256_set1_pd(1.0);
+    for(size_t i = 0; i < steps; i++){
+        // Both halves are independent, so they fill the pipeline together
+        for(int h = 0; h < RNG_LANES/4; h++){
+            __m256i x = _mm256_add_epi64(s[1][h], _mm256_slli_epi64(s[1][h], 2));
+            x = _mm256_or_si256(_mm256_slli_epi64(x, 7), _mm256_srli_epi64(x, 57));
+            x = _mm256_add_epi64(x, _mm256_slli_epi64(x, 3));
+            __m256i t = _mm256_slli_epi64(s[1][h], 17);
+            s[2][h] = _mm256_xor_si256(s[2][h], s[0][h]);
+            s[3][h] = _mm256_xor_si256(s[3][h], s[1][h]);
+            s[1][h] = _mm256_xor_si256(s[1][h], s[2][h]);
+            s[0][h] = _mm256_xor_si256(s[0][h], s[3][h]);
+            s[2][h] = _mm256_xor_si256(s[2][h], t);
+            s[3][h] = _mm256_or_si256(_mm256_slli_epi64(s[3][h], 45), _mm256_srli_epi64(s[3][h], 19));
+            __m256d d = _mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(x, 12), one));
+            _mm256_storeu_pd(out + i*RNG_LANES + h*4, _mm256_sub_pd(d, done));
+        }
+    }
+    for(int w = 0; w < 4; w++){
+        for(int h = 0; h < RNG_LANES/4; h++){
+            _mm256_store_si256((__m256i *)&(g->s[w][h*4]), s[w][h]);
+        }
+    }
+}
+
+/**
+ * Updates row of particles using AVX2
+ * @param velocity Row of velocities
+ * @param position Row of positions
+ * @param rand_p Cognitive random numbers
+ * @param rand_g Social random numbers
+ * @param personal Row of personal best coordinates (NULL if social attractor is used instead)
+ * @param social Row of social attractors (NULL if all particles use prm->social)
+ * @param rand_r Random numbers for positions of particles which crossed bounds (NULL if they are not reinitialized)
+ * @param n Amount of particles in the row
+ * @param prm Update parameters
+ */
+TARGET_AVX2 static void row_update_avx2(double *velocity, double *position, const double *rand_p, const double *rand_g, const double *personal, const double *social, const double *rand_r, size_t n, const TRowUpdate *prm){
+    const __m256d w = _mm256_set1_pd(prm->w);
+    const __m256d cp = _mm256_set1_pd(prm->cp);
+    const __m256d cg = _mm256_set1_pd(prm->cg);
+    const __m256d gbest = _mm256_set1_pd(prm->social);
+    const __m256d min = _mm256_set1_pd(prm->min);
+    const __m256d max = _mm256_set1_pd(prm->max);
+    const __m256d range = _mm256_set1_pd(prm->max - prm->min);
+    const __m256d vmax = _mm256_set1_pd(prm->vmax);
+    const __m256d nvmax = _mm256_set1_pd(-prm->vmax);
+    const __m256d bounce = _mm256_set1_pd(prm->bounce);
+    size_t a = 0;
+    for(; a + 4 <= n; a += 4){
+        __m256d x = _mm256_loadu_pd(position + a);
+        // Choice is the same for whole row, so the branch is always predicted
+        __m256d g = social ? _mm256_loadu_pd(social + a) : gbest;
+        __m256d p = personal ? _mm256_loadu_pd(personal + a) : g;
+        __m256d dp = _mm256_sub_pd(p, x);
+        __m256d d = _mm256_sub_pd(g, x);
+        __m256d v = _mm256_mul_pd(w, _mm256_loadu_pd(velocity + a));
+        v = _mm256_add_pd(v, _mm256_mul_pd(_mm256_mul_pd(cp, _mm256_loadu_pd(rand_p + a)), dp));
+        v = _mm256_add_pd(v, _mm256_mul_pd(_mm256_mul_pd(cg, _mm256_loadu_pd(rand_g + a)), d));
+        v = _mm256_min_pd(_mm256_max_pd(v, nvmax), vmax);
+        x = _mm256_add_pd(x, v);
+        __m256d xc = _mm256_min_pd(_mm256_max_pd(x, min), max);
+        __m256d out = _mm256_cmp_pd(xc, x, _CMP_NEQ_UQ);
+        if(prm->reflect){
+            __m256d xr = _mm256_sub_pd(_mm256_add_pd(xc, xc), x);
+            xr = _mm256_min_pd(_mm256_max_pd(xr, min), max);
+            xc = _mm256_blendv_pd(xc, xr, out);
+        }
+        if(rand_r){
+            __m256d xn = _mm256_add_pd(min, _mm256_mul_pd(_mm256_loadu_pd(rand_r + a), range));
+            xc = _mm256_blendv_pd(xc, xn, out);
+        }
+        v = _mm256_blendv_pd(v, _mm256_mul_pd(v, bounce), out);
+        _mm256_storeu_pd(velocity + a, v);
+        _mm256_storeu_pd(position + a, xc);
+    }
+    // Compiler does not clear upper halves before tail call, SSE code after dirty
+    //  upper state would run with transition penalty (objective functions too)
+    _mm256_zeroupper();
+    row_update_scalar(velocity + a, position + a, rand_p + a, rand_g + a, personal ? personal + a : NULL, social ? social + a : NULL,
+                      rand_r ? rand_r + a : NULL, n - a, prm);
+}
+
+/**
+ * Generates single precision values in all lanes using AVX2
+ * @param g Generator lanes
+ * @param out Array to be filled
+ * @param steps How many values should every lane generate
+ */
+TARGET_AVX2 static void rng_fill_float_avx2(TRngLanes *g, float *out, size_t steps){
+    __m256i s[4][RNG_LANES/4];
+    for(int w = 0; w < 4; w++){
+        for(int h = 0; h < RNG_LANES/4; h++){
+            s[w][h] = _mm256_load_si256((const __m256i *)&(g->s[w][h*4]));
+        }
+    }
+    const __m256i one = _mm256_set1_epi64x(FLOAT_ONE_BITS);
+    const __m256 fone = _mm256_set1_ps(1.0f);
+    for(size_t i = 0; i < steps; i++){
+        __m256i bits[RNG_LANES/4];
+        for(int h = 0; h < RNG_LANES/4; h++){
+            __m256i x = _mm256_add_epi64(s[1][h], _mm256_slli_epi64(s[1][h], 2));
+            x = _mm256_or_si256(_mm256_slli_epi64(x, 7), _mm256_srli_epi64(x, 57));
+            x = _mm256_add_epi64(x, _mm256_slli_epi64(x, 3));
+            __m256i t = _mm256_slli_epi64(s[1][h], 17);
+            s[2][h] = _mm256_xor_si256(s[2][h], s[0][h]);
+            s[3][h] = _mm256_xor_si256(s[3][h], s[1][h]);
+            s[1][h] = _mm256_xor_si256(s[1][h], s[2][h]);
+            s[0][h] = _mm256_xor_si256(s[0][h], s[3][h]);
+            s[2][h] = _mm256_xor_si256(s[2][h], t);
+            s[3][h] = _mm256_or_si256(_mm256_slli_epi64(s[3][h], 45), _mm256_srli_epi64(s[3][h], 19));
+            bits[h] = _mm256_or_si256(_mm256_srli_epi64(x, 41), one);
+        }
+        // Shuffle works within 128 bit halves, so 64 bit pairs are put back in lane order after it
+        __m256 f = _mm256_shuffle_ps(_mm256_castsi256_ps(bits[0]), _mm256_castsi256_ps(bits[1]), _MM_SHUFFLE(2, 0, 2, 0));
+        f = _mm256_castsi256_ps(_mm256_permute4x64_epi64(_mm256_castps_si256(f), _MM_SHUFFLE(3, 1, 2, 0)));
+        _mm256_storeu_ps(out + i*RNG_LANES, _mm256_sub_ps(f, fone));
+    }
+    for(int w = 0; w < 4; w++){
+        for(int h = 0; h < RNG_LANES/4; h++){
+            _mm256_store_si256((__m256i *)&(g->s[w][h*4]), s[w][h]);
+        }
+    }
+    _mm256_zeroupper();
+}
+
+/**
+ * Updates row of single precision particles using AVX2
+ * @param velocity Row of velocities
+ * @param position Row of positions
+ * @param rand_p Cognitive random numbers
+ * @param rand_g Social random numbers
+ * @param personal Row of personal best coordinates (NULL if social attractor is used instead)
+ * @param social Row of social attractors (NULL if all particles use prm->social)
+ * @param rand_r Random numbers for positions of particles which crossed bounds (NULL if they are not reinitialized)
+ * @param n Amount of particles in the row
+ * @param prm Update parameters (rounded to single precision)
+ */
+TARGET_AVX2 static void row_update_float_avx2(float *velocity, float *position, const float *rand_p, const float *rand_g, const float *personal, const float *social, const float *rand_r, size_t n, const TRowUpdate *prm){
+    const __m256 w = _mm256_set1_ps((float)prm->w);
+    const __m256 cp = _mm256_set1_ps((float)prm->cp);
+    const __m256 cg = _mm256_set1_ps((float)prm->cg);
+    const __m256 gbest = _mm256_set1_ps((float)prm->social);
+    const __m256 min = _mm256_set1_ps((float)prm->min);
+    const __m256 max = _mm256_set1_ps((float)prm->max);
+    const __m256 range = _mm256_set1_ps((float)prm->max - (float)prm->min);
+    const __m256 vmax = _mm256_set1_ps((float)prm->vmax);
+    const __m256 nvmax = _mm256_set1_ps(-(float)prm->vmax);
+    const __m256 bounce = _mm256_set1_ps((float)prm->bounce);
+    size_t a = 0;
+    for(; a + 8 <= n; a += 8){
+        __m256 x = _mm256_loadu_ps(position + a);
+        __m256 g = social ? _mm256_loadu_ps(social + a) : gbest;
+        __m256 p = personal ? _mm256_loadu_ps(personal + a) : g;
+        __m256 dp = _mm256_sub_ps(p, x);
+        __m256 d = _mm256_sub_ps(g, x);
+        __m256 v = _mm256_mul_ps(w, _mm256_loadu_ps(velocity + a));
+        v = _mm256_add_ps(v, _mm256_mul_ps(_mm256_mul_ps(cp, _mm256_loadu_ps(rand_p + a)), dp));
+        v = _mm256_add_ps(v, _mm256_mul_ps(_mm256_mul_ps(cg, _mm256_loadu_ps(rand_g + a)), d));
+        v = _mm256_min_ps(_mm256_max_ps(v, nvmax), vmax);
+        x = _mm256_add_ps(x, v);
+        __m256 xc = _mm256_min_ps(_mm256_max_ps(x, min), max);
+        __m256 out = _mm256_cmp_ps(xc, x, _CMP_NEQ_UQ);
+        if(prm->reflect){
+            __m256 xr = _mm256_sub_ps(_mm256_add_ps(xc, xc), x);
+            xr = _mm256_min_ps(_mm256_max_ps(xr, min), max);
+            xc = _mm256_blendv_ps(xc, xr, out);
+        }
+        if(rand_r){
+            __m256 xn = _mm256_add_ps(min, _mm256_mul_ps(_mm256_loadu_ps(rand_r + a), range));
+            xc = _mm256_blendv_ps(xc, xn, out);
+        }
+        v = _mm256_blendv_ps(v, _mm256_mul_ps(v, bounce), out);
+        _mm256_storeu_ps(velocity + a, v);
+        _mm256_storeu_ps(position + a, xc);
+    }
+    // Same as in row_update_avx2
+    _mm256_zeroupper();
+    row_update_float_scalar(velocity + a, position + a, rand_p + a, rand_g + a, personal ? personal + a : NULL, social ? social + a : NULL,
+                            rand_r ? rand_r + a : NULL, n - a, prm);
+}
+
+/**
+ * Compares row of values with one value using AVX2 (see row_compare_scalar)
+ */
+TARGET_AVX2 static uint64_t row_compare_avx2(const double *row, double x, size_t n, uint64_t *flags){
+    const __m256d vx = _mm256_set1_pd(x);
+    const __m256i one = _mm256_set1_epi64x(1);
+    const __m256i two = _mm256_set1_epi64x(2);
+    __m256i all = _mm256_set1_epi64x(-1);
+    size_t j = 0;
+    for(; j + 4 <= n; j += 4){
+        __m256d r = _mm256_loadu_pd(row + j);
+        __m256i lt = _mm256_and_si256(_mm256_castpd_si256(_mm256_cmp_pd(r, vx, _CMP_LT_OQ)), one);
+        __m256i gt = _mm256_and_si256(_mm256_castpd_si256(_mm256_cmp_pd(vx, r, _CMP_LT_OQ)), two);
+        __m256i f = _mm256_or_si256(_mm256_loadu_si256((const __m256i *)(flags + j)), _mm256_or_si256(lt, gt));
+        _mm256_storeu_si256((__m256i *)(flags + j), f);
+        all = _mm256_and_si256(all, f);
+    }
+    uint64_t lanes[4];
+    _mm256_storeu_si256((__m256i *)lanes, all);
+    _mm256_zeroupper();
+    return lanes[0] & lanes[1] & lanes[2] & lanes[3] & row_compare_scalar(row + j, x, n - j, flags + j);
+}
+
+/**
+ * Generates values in all lanes using AVX-512
+ * @param g Generator lanes
+ * @param out Array to be filled
+ * @param steps How many values should every lane generate
+ */
+TARGET_AVX512 static void rng_fill_avx512(TRngLanes *g, double *out, size_t steps){
+    __m512i s[4];
+    for(int w = 0; w < 4; w++){
+        s[w] = _mm512_load_si512(&(g->s[w][0]));
+    }
+    const __m512i one = _mm512_set1_epi64((long long)DOUBLE_ONE_BITS);
+    const __m512d done = _mm512_set1_pd(1.0);
+    for(size_t i = 0; i < steps; i++){
+        __m512i x = _mm512_add_epi64(s[1], _mm512_slli_epi64(s[1], 2));
+        x = _mm512_rol_epi64(x, 7);
+        x = _mm512_add_epi64(x, _mm512_slli_epi64(x, 3));
+        __m512i t = _mm512_slli_epi64(s[1], 17);
+        s[2] = _mm512_xor_si512(s[2], s[0]);
+        s[3] = _mm512_xor_si512(s[3], s[1]);
+        s[1] = _mm512_xor_si512(s[1], s[2]);
+        s[0] = _mm512_xor_si512(s[0], s[3]);
+        s[2] = _mm512_xor_si512(s[2], t);
+        s[3] = _mm512_rol_epi64(s[3], 45);
+        __m512d d = _mm512_castsi512_pd(_mm512_or_si512(_mm512_srli_epi64(x, 12), one));
+        _mm512_storeu_pd(out + i*RNG_LANES, _mm512_sub_pd(d, done));
+    }
+    for(int w = 0; w < 4; w++){
+        _mm512_store_si512(&(g->s[w][0]), s[w]);
+    }
+}
+
+/**
+ * Updates row of particles using AVX-512
+ * @param velocity Row of velocities
+ * @param position Row of positions
+ * @param rand_p Cognitive random numbers
+ * @param rand_g Social random numbers
+ * @param personal Row of personal best coordinates (NULL if social attractor is used instead)
+ * @param social Row of social attractors (NULL if all particles use prm->social)
+ * @param rand_r Random numbers for positions of particles which crossed bounds (NULL if they are not reinitialized)
+ * @param n Amount of particles in the row
+ * @param prm Update parameters
+ */
+TARGET_AVX512 static void row_update_avx512(double *velocity, double *position, const double *rand_p, const double *rand_g, const double *personal, const double *social, const double *rand_r, size_t n, const TRowUpdate *prm){
+    const __m512d w = _mm512_set1_pd(prm->w);
+    const __m512d cp = _mm512_set1_pd(prm->cp);
+    const __m512d cg = _mm512_set1_pd(prm->cg);
+    const __m512d gbest = _mm512_set1_pd(prm->social);
+    const __m512d min = _mm512_set1_pd(prm->min);
+    const __m512d max = _mm512_set1_pd(prm->max);
+    const __m512d range = _mm512_set1_pd(prm->max - prm->min);
+    const __m512d vmax = _mm512_set1_pd(prm->vmax);
+    const __m512d nvmax = _mm512_set1_pd(-prm->vmax);
+    const __m512d bounce = _mm512_set1_pd(prm->bounce);
+    size_t a = 0;
+    for(; a + 8 <= n; a += 8){
+        __m512d x = _mm512_loadu_pd(position + a);
+        // Choice is the same for whole row, so the branch is always predicted
+        __m512d g = social ? _mm512_loadu_pd(social + a) : gbest;
+        __m512d p = personal ? _mm512_loadu_pd(personal + a) : g;
+        __m512d dp = _mm512_sub_pd(p, x);
+        __m512d d = _mm512_sub_pd(g, x);
+        __m512d v = _mm512_mul_pd(w, _mm512_loadu_pd(velocity + a));
+        v = _mm512_add_pd(v, _mm512_mul_pd(_mm512_mul_pd(cp, _mm512_loadu_pd(rand_p + a)), dp));
+        v = _mm512_add_pd(v, _mm512_mul_pd(_mm512_mul_pd(cg, _mm512_loadu_pd(rand_g + a)), d));
+        v = _mm512_min_pd(_mm512_max_pd(v, nvmax), vmax);
+        x = _mm512_add_pd(x, v);
+        __m512d xc = _mm512_min_pd(_mm512_max_pd(x, min), max);
+        __mmask8 out = _mm512_cmp_pd_mask(xc, x, _CMP_NEQ_UQ);
+        if(prm->reflect){
+            __m512d xr = _mm512_sub_pd(_mm512_add_pd(xc, xc), x);
+            xr = _mm512_min_pd(_mm512_max_pd(xr, min), max);
+            xc = _mm512_mask_blend_pd(out, xc, xr);
+        }
+        if(rand_r){
+            __m512d xn = _mm512_add_pd(min, _mm512_mul_pd(_mm512_loadu_pd(rand_r + a), range));
+            xc = _mm512_mask_blend_pd(out, xc, xn);
+        }
+        v = _mm512_mask_mul_pd(v, out, v, bounce);
+        _mm512_storeu_pd(velocity + a, v);
+        _mm512_storeu_pd(position + a, xc);
+    }
+    // Same as in row_update_avx2
+    _mm256_zeroupper();
+    row_update_scalar(velocity + a, position + a, rand_p + a, rand_g + a, personal ? personal + a : NULL, social ? social + a : NULL,
+                      rand_r ? rand_r + a : NULL, n - a, prm);
+}
+/**
+ * Generates single precision values in all lanes using AVX-512
+ * @param g Generator lanes
+ * @param out Array to be filled
+ * @param steps How many values should every lane generate
+ */
+TARGET_AVX512 static void rng_fill_float_avx512(TRngLanes *g, float *out, size_t steps){
+    __m512i s[4];
+    for(int w = 0; w < 4; w++){
+        s[w] = _mm512_load_si512(&(g->s[w][0]));
+    }
+    const __m256i one = _mm256_set1_epi32((int)FLOAT_ONE_BITS);
+    const __m256 fone = _mm256_set1_ps(1.0f);
+    for(size_t i = 0; i < steps; i++){
+        __m512i x = _mm512_add_epi64(s[1], _mm512_slli_epi64(s[1], 2));
+        x = _mm512_rol_epi64(x, 7);
+        x = _mm512_add_epi64(x, _mm512_slli_epi64(x, 3));
+        __m512i t = _mm512_slli_epi64(s[1], 17);
+        s[2] = _mm512_xor_si512(s[2], s[0]);
+        s[3] = _mm512_xor_si512(s[3], s[1]);
+        s[1] = _mm512_xor_si512(s[1], s[2]);
+        s[0] = _mm512_xor_si512(s[0], s[3]);
+        s[2] = _mm512_xor_si512(s[2], t);
+        s[3] = _mm512_rol_epi64(s[3], 45);
+        // Lanes are narrowed to 32 bits, so that 8 floats are made at once
+        __m256i bits = _mm256_or_si256(_mm512_cvtepi64_epi32(_mm512_srli_epi64(x, 41)), one);
+        _mm256_storeu_ps(out + i*RNG_LANES, _mm256_sub_ps(_mm256_castsi256_ps(bits), fone));
+    }
+    for(int w = 0; w < 4; w++){
+        _mm512_store_si512(&(g->s[w][0]), s[w]);
+    }
+    _mm256_zeroupper();
+}
+
+/**
+ * Updates row of single precision particles using AVX-512
+ * @param velocity Row of velocities
+ * @param position Row of positions
+ * @param rand_p Cognitive random numbers
+ * @param rand_g Social random numbers
+ * @param personal Row of personal best coordinates (NULL if social attractor is used instead)
+ * @param social Row of social attractors (NULL if all particles use prm->social)
+ * @param rand_r Random numbers for positions of particles which crossed bounds (NULL if they are not reinitialized)
+ * @param n Amount of particles in the row
+ * @param prm Update parameters (rounded to single precision)
+ */
+TARGET_AVX512 static void row_update_float_avx512(float *velocity, float *position, const float *rand_p, const float *rand_g, const float *personal, const float *social, const float *rand_r, size_t n, const TRowUpdate *prm){
+    const __m512 w = _mm512_set1_ps((float)prm->w);
+    const __m512 cp = _mm512_set1_ps((float)prm->cp);
+    const __m512 cg = _mm512_set1_ps((float)prm->cg);
+    const __m512 gbest = _mm512_set1_ps((float)prm->social);
+    const __m512 min = _mm512_set1_ps((float)prm->min);
+    const __m512 max = _mm512_set1_ps((float)prm->max);
+    const __m512 range = _mm512_set1_ps((float)prm->max - (float)prm->min);
+    const __m512 vmax = _mm512_set1_ps((float)prm->vmax);
+    const __m512 nvmax = _mm512_set1_ps(-(float)prm->vmax);
+    const __m512 bounce = _mm512_set1_ps((float)prm->bounce);
+    size_t a = 0;
+    for(; a + 16 <= n; a += 16){
+        __m512 x = _mm512_loadu_ps(position + a);
+        __m512 g = social ? _mm512_loadu_ps(social + a) : gbest;
+        __m512 p = personal ? _mm512_loadu_ps(personal + a) : g;
+        __m512 dp = _mm512_sub_ps(p, x);
+        __m512 d = _mm512_sub_ps(g, x);
+        __m512 v = _mm512_mul_ps(w, _mm512_loadu_ps(velocity + a));
+        v = _mm512_add_ps(v, _mm512_mul_ps(_mm512_mul_ps(cp, _mm512_loadu_ps(rand_p + a)), dp));
+        v = _mm512_add_ps(v, _mm512_mul_ps(_mm512_mul_ps(cg, _mm512_loadu_ps(rand_g + a)), d));
+        v = _mm512_min_ps(_mm512_max_ps(v, nvmax), vmax);
+        x = _mm512_add_ps(x, v);
+        __m512 xc = _mm512_min_ps(_mm512_max_ps(x, min), max);
+        __mmask16 out = _mm512_cmp_ps_mask(xc, x, _CMP_NEQ_UQ);
+        if(prm->reflect){
+            __m512 xr = _mm512_sub_ps(_mm512_add_ps(xc, xc), x);
+            xr = _mm512_min_ps(_mm512_max_ps(xr, min), max);
+            xc = _mm512_mask_blend_ps(out, xc, xr);
+        }
+        if(rand_r){
+            __m512 xn = _mm512_add_ps(min, _mm512_mul_ps(_mm512_loadu_ps(rand_r + a), range));
+            xc = _mm512_mask_blend_ps(out, xc, xn);
+        }
+        v = _mm512_mask_mul_ps(v, out, v, bounce);
+        _mm512_storeu_ps(velocity + a, v);
+        _mm512_storeu_ps(position + a, xc);
+    }
+    // Same as in row_update_avx2
+    _mm256_zeroupper();
+    row_update_float_scalar(velocity + a, position + a, rand_p + a, rand_g + a, personal ? personal + a : NULL, social ? social + a : NULL,
+                            rand_r ? rand_r + a : NULL, n - a, prm);
+}
+
+/**
+ * Compares row of values with one value using AVX-512 (see row_compare_scalar)
+ */
+TARGET_AVX512 static uint64_t row_compare_avx512(const double *row, double x, size_t n, uint64_t *flags){
+    const __m512d vx = _mm512_set1_pd(x);
+    const __m512i one = _mm512_set1_epi64(1);
+    const __m512i two = _mm512_set1_epi64(2);
+    __m512i all = _mm512_set1_epi64(-1);
+    size_t j = 0;
+    for(; j + 8 <= n; j += 8){
+        __m512d r = _mm512_loadu_pd(row + j);
+        __m512i lt = _mm512_maskz_mov_epi64(_mm512_cmp_pd_mask(r, vx, _CMP_LT_OQ), one);
+        __m512i gt = _mm512_maskz_mov_epi64(_mm512_cmp_pd_mask(vx, r, _CMP_LT_OQ), two);
+        __m512i f = _mm512_or_epi64(_mm512_loadu_si512(flags + j), _mm512_or_epi64(lt, gt));
+        _mm512_storeu_si512(flags + j, f);
+        all = _mm512_and_epi64(all, f);
+    }
+    uint64_t lanes[8];
+    _mm512_storeu_si512(lanes, all);
+    _mm256_zeroupper();
+    uint64_t rest = row_compare_scalar(row + j, x, n - j, flags + j);
+    for(int l = 0; l < 8; l++){
+        rest &= lanes[l];
+    }
+    return rest;
+}
+#endif // SIMD_X86
+
+#ifdef SIMD_NEON
+/**
+ * Generates values in all lanes using NEON
+ * @param g Generator lanes
+ * @param out Array to be filled
+ * @param steps How many values should every lane generate
+ */
+static void rng_fill_neon(TRngLanes *g, double *out, size_t steps){
+    uint64x2_t s[4][RNG_LANES/2];
+    for(int w = 0; w < 4; w++){
+        for(int h = 0; h < RNG_LANES/2; h++){
+            s[w][h] = vld1q_u64(&(g->s[w][h*2]));
+        }
+    }
+    const uint64x2_t one = vdupq_n_u64(DOUBLE_ONE_BITS);
+    const float64x2_t done = vdupq_n_f64(1.0);
+    for(size_t i = 0; i < steps; i++){
+        for(int h = 0; h < RNG_LANES/2; h++){
+            uint64x2_t x = vaddq_u64(s[1][h], vshlq_n_u64(s[1][h], 2));
+            x = vorrq_u64(vshlq_n_u64(x, 7), vshrq_n_u64(x, 57));
+            x = vaddq_u64(x, vshlq_n_u64(x, 3));
+            uint64x2_t t = vshlq_n_u64(s[1][h], 17);
+            s[2][h] = veorq_u64(s[2][h], s[0][h]);
+            s[3][h] = veorq_u64(s[3][h], s[1][h]);
+            s[1][h] = veorq_u64(s[1][h], s[2][h]);
+            s[0][h] = veorq_u64(s[0][h], s[3][h]);
+            s[2][h] = veorq_u64(s[2][h], t);
+            s[3][h] = vorrq_u64(vshlq_n_u64(s[3][h], 45), vshrq_n_u64(s[3][h], 19));
+            float64x2_t d = vreinterpretq_f64_u64(vorrq_u64(vshrq_n_u64(x, 12), one));
+            vst1q_f64(out + i*RNG_LANES + h*2, vsubq_f64(d, done));
+        }
+    }
+    for(int w = 0; w < 4; w++){
+        for(int h = 0; h < RNG_LANES/2; h++){
+            vst1q_u64(&(g->s[w][h*2]), s[w][h]);
+        }
+    }
+}
+
+/**
+ * Updates row of particles using NEON
+ * @param velocity Row of velocities
+ * @param position Row of positions
+ * @param rand_p Cognitive random numbers
+ * @param rand_g Social random numbers
+ * @param personal Row of personal best coordinates (NULL if social attractor is used instead)
+ * @param social Row of social attractors (NULL if all particles use prm->social)
+ * @param rand_r Random numbers for positions of particles which crossed bounds (NULL if they are not reinitialized)
+ * @param n Amount of particles in the row
+ * @param prm Update parameters
+ */
+static void row_update_neon(double *velocity, double *position, const double *rand_p, const double *rand_g, const double *personal, const double *social, const double *rand_r, size_t n, const TRowUpdate *prm){
+    const float64x2_t w = vdupq_n_f64(prm->w);
+    const float64x2_t cp = vdupq_n_f64(prm->cp);
+    const float64x2_t cg = vdupq_n_f64(prm->cg);
+    const float64x2_t gbest = vdupq_n_f64(prm->social);
+    const float64x2_t min = vdupq_n_f64(prm->min);
+    const float64x2_t max = vdupq_n_f64(prm->max);
+    const float64x2_t range = vdupq_n_f64(prm->max - prm->min);
+    const float64x2_t vmax = vdupq_n_f64(prm->vmax);
+    const float64x2_t nvmax = vdupq_n_f64(-prm->vmax);
+    const float64x2_t bounce = vdupq_n_f64(prm->bounce);
+    size_t a = 0;
+    for(; a + 2 <= n; a += 2){
+        float64x2_t x = vld1q_f64(position + a);
+        // Choice is the same for whole row, so the branch is always predicted
+        float64x2_t g = social ? vld1q_f64(social + a) : gbest;
+        float64x2_t p = personal ? vld1q_f64(personal + a) : g;
+        float64x2_t dp = vsubq_f64(p, x);
+        float64x2_t d = vsubq_f64(g, x);
+        float64x2_t v = vmulq_f64(w, vld1q_f64(velocity + a));
+        v = vaddq_f64(v, vmulq_f64(vmulq_f64(cp, vld1q_f64(rand_p + a)), dp));
+        v = vaddq_f64(v, vmulq_f64(vmulq_f64(cg, vld1q_f64(rand_g + a)), d));
+        // Compare and select keeps the same NaN handling as the scalar code
+        v = vbslq_f64(vcgtq_f64(v, nvmax), v, nvmax);
+        v = vbslq_f64(vcltq_f64(v, vmax), v, vmax);
+        x = vaddq_f64(x, v);
+        float64x2_t xc = vbslq_f64(vcgtq_f64(x, min), x, min);
+        xc = vbslq_f64(vcltq_f64(xc, max), xc, max);
+        uint64x2_t in = vceqq_f64(xc, x);
+        if(prm->reflect){
+            float64x2_t xr = vsubq_f64(vaddq_f64(xc, xc), x);
+            xr = vbslq_f64(vcgtq_f64(xr, min), xr, min);
+            xr = vbslq_f64(vcltq_f64(xr, max), xr, max);
+            xc = vbslq_f64(in, xc, xr);
+        }
+        if(rand_r){
+            float64x2_t xn = vaddq_f64(min, vmulq_f64(vld1q_f64(rand_r + a), range));
+            xc = vbslq_f64(in, xc, xn);
+        }
+        v = vbslq_f64(in, v, vmulq_f64(v, bounce));
+        vst1q_f64(velocity + a, v);
+        vst1q_f64(position + a, xc);
+    }
+    row_update_scalar(velocity + a, position + a, rand_p + a, rand_g + a, personal ? personal + a : NULL, social ? social + a : NULL,
+                      rand_r ? rand_r + a : NULL, n - a, prm);
+}
+
+/**
+ * Generates single precision values in all lanes using NEON
+ * @param g Generator lanes
+ * @param out Array to be filled
+ * @param steps How many values should every lane generate
+ */
+static void rng_fill_float_neon(TRngLanes *g, float *out, size_t steps){
+    uint64x2_t s[4][RNG_LANES/2];
+    for(int w = 0; w < 4; w++){
+        for(int h = 0; h < RNG_LANES/2; h++){
+            s[w][h] = vld1q_u64(&(g->s[w][h*2]));
+        }
+    }
+    const uint32x4_t one = vdupq_n_u32(FLOAT_ONE_BITS);
+    const float32x4_t fone = vdupq_n_f32(1.0f);
+    for(size_t i = 0; i < steps; i++){
+        uint32x2_t bits[RNG_LANES/2];
+        for(int h = 0; h < RNG_LANES/2; h++){
+            uint64x2_t x = vaddq_u64(s[1][h], vshlq_n_u64(s[1][h], 2));
+            x = vorrq_u64(vshlq_n_u64(x, 7), vshrq_n_u64(x, 57));
+            x = vaddq_u64(x, vshlq_n_u64(x, 3));
+            uint64x2_t t = vshlq_n_u64(s[1][h], 17);
+            s[2][h] = veorq_u64(s[2][h], s[0][h]);
+            s[3][h] = veorq_u64(s[3][h], s[1][h]);
+            s[1][h] = veorq_u64(s[1][h], s[2][h]);
+            s[0][h] = veorq_u64(s[0][h], s[3][h]);
+            s[2][h] = veorq_u64(s[2][h], t);
+            s[3][h] = vorrq_u64(vshlq_n_u64(s[3][h], 45), vshrq_n_u64(s[3][h], 19));
+            bits[h] = vmovn_u64(vshrq_n_u64(x, 41));
+        }
+        for(int h = 0; h < RNG_LANES/2; h += 2){
+            float32x4_t f = vreinterpretq_f32_u32(vorrq_u32(vcombine_u32(bits[h], bits[h + 1]), one));
+            vst1q_f32(out + i*RNG_LANES + h*2, vsubq_f32(f, fone));
+        }
+    }
+    for(int w = 0; w < 4; w++){
+        for(int h = 0; h < RNG_LANES/2; h++){
+            vst1q_u64(&(g->s[w][h*2]), s[w][h]);
+        }
+    }
+}
+
+/**
+ * Updates row of single precision particles using NEON
+ * @param velocity Row of velocities
+ * @param position Row of positions
+ * @param rand_p Cognitive random numbers
+ * @param rand_g Social random numbers
+ * @param personal Row of personal best coordinates (NULL if social attractor is used instead)
+ * @param social Row of social attractors (NULL if all particles use prm->social)
+ * @param rand_r Random numbers for positions of particles which crossed bounds (NULL if they are not reinitialized)
+ * @param n Amount of particles in the row
+ * @param prm Update parameters (rounded to single precision)
+ */
+static void row_update_float_neon(float *velocity, float *position, const float *rand_p, const float *rand_g, const float *personal, const float *social, const float *rand_r, size_t n, const TRowUpdate *prm){
+    const float32x4_t w = vdupq_n_f32((float)prm->w);
+    const float32x4_t cp = vdupq_n_f32((float)prm->cp);
+    const float32x4_t cg = vdupq_n_f32((float)prm->cg);
+    const float32x4_t gbest = vdupq_n_f32((float)prm->social);
+    const float32x4_t min = vdupq_n_f32((float)prm->min);
+    const float32x4_t max = vdupq_n_f32((float)prm->max);
+    const float32x4_t range = vdupq_n_f32((float)prm->max - (float)prm->min);
+    const float32x4_t vmax = vdupq_n_f32((float)prm->vmax);
+    const float32x4_t nvmax = vdupq_n_f32(-(float)prm->vmax);
+    const float32x4_t bounce = vdupq_n_f32((float)prm->bounce);
+    size_t a = 0;
+    for(; a + 4 <= n; a += 4){
+        float32x4_t x = vld1q_f32(position + a);
+        float32x4_t g = social ? vld1q_f32(social + a) : gbest;
+        float32x4_t p = personal ? vld1q_f32(personal + a) : g;
+        float32x4_t dp = vsubq_f32(p, x);
+        float32x4_t d = vsubq_f32(g, x);
+        float32x4_t v = vmulq_f32(w, vld1q_f32(velocity + a));
+        v = vaddq_f32(v, vmulq_f32(vmulq_f32(cp, vld1q_f32(rand_p + a)), dp));
+        v = vaddq_f32(v, vmulq_f32(vmulq_f32(cg, vld1q_f32(rand_g + a)), d));
+        v = vbslq_f32(vcgtq_f32(v, nvmax), v, nvmax);
+        v = vbslq_f32(vcltq_f32(v, vmax), v, vmax);
+        x = vaddq_f32(x, v);
+        float32x4_t xc = vbslq_f32(vcgtq_f32(x, min), x, min);
+        xc = vbslq_f32(vcltq_f32(xc, max), xc, max);
+        uint32x4_t in = vceqq_f32(xc, x);
+        if(prm->reflect){
+            float32x4_t xr = vsubq_f32(vaddq_f32(xc, xc), x);
+            xr = vbslq_f32(vcgtq_f32(xr, min), xr, min);
+            xr = vbslq_f32(vcltq_f32(xr, max), xr, max);
+            xc = vbslq_f32(in, xc, xr);
+        }
+        if(rand_r){
+            float32x4_t xn = vaddq_f32(min, vmulq_f32(vld1q_f32(rand_r + a), range));
+            xc = vbslq_f32(in, xc, xn);
+        }
+        v = vbslq_f32(in, v, vmulq_f32(v, bounce));
+        vst1q_f32(velocity + a, v);
+        vst1q_f32(position + a, xc);
+    }
+    row_update_float_scalar(velocity + a, position + a, rand_p + a, rand_g + a, personal ? personal + a : NULL, social ? social + a : NULL,
+                            rand_r ? rand_r + a : NULL, n - a, prm);
+}
+
+/**
+ * Compares row of values with one value using NEON (see row_compare_scalar)
+ */
+static uint64_t row_compare_neon(const double *row, double x, size_t n, uint64_t *flags){
+    const float64x2_t vx = vdupq_n_f64(x);
+    const uint64x2_t one = vdupq_n_u64(1);
+    const uint64x2_t two = vdupq_n_u64(2);
+    uint64x2_t all = vdupq_n_u64(~(uint64_t)0);
+    size_t j = 0;
+    for(; j + 2 <= n; j += 2){
+        float64x2_t r = vld1q_f64(row + j);
+        uint64x2_t lt = vandq_u64(vcltq_f64(r, vx), one);
+        uint64x2_t gt = vandq_u64(vcltq_f64(vx, r), two);
+        uint64x2_t f = vorrq_u64(vld1q_u64(flags + j), vorrq_u64(lt, gt));
+        vst1q_u64(flags + j, f);
+        all = vandq_u64(all, f);
+    }
+    return vgetq_lane_u64(all, 0) & vgetq_lane_u64(all, 1) & row_compare_scalar(row + j, x, n - j, flags + j);
+}
+#endif // SIMD_NEON
+
+/**
+ * Implementations for each instruction set (indexed by TPSOIsa)
+ * Instruction sets not compiled for this target have plain C implementations
+ */
+static const TSimdKernels simd_kernels[] = {
+    [PSO_ISA_SCALAR] = {rng_fill_scalar, row_update_scalar, rng_fill_float_scalar, row_update_float_scalar, row_compare_scalar},
+#ifdef SIMD_X86
+    [PSO_ISA_SSE2] = {rng_fill_sse2, row_update_sse2, rng_fill_float_sse2, row_update_float_sse2, row_compare_sse2},
+    [PSO_ISA_AVX2] = {rng_fill_avx2, row_update_avx2, rng_fill_float_avx2, row_update_float_avx2, row_compare_avx2},
+    [PSO_ISA_AVX512] = {rng_fill_avx512, row_update_avx512, rng_fill_float_avx512, row_update_float_avx512, row_compare_avx512},
+#else
+    [PSO_ISA_SSE2] = {rng_fill_scalar, row_update_scalar, rng_fill_float_scalar, row_update_float_scalar, row_compare_scalar},
+    [PSO_ISA_AVX2] = {rng_fill_scalar, row_update_scalar, rng_fill_float_scalar, row_update_float_scalar, row_compare_scalar},
+    [PSO_ISA_AVX512] = {rng_fill_scalar, row_update_scalar, rng_fill_float_scalar, row_update_float_scalar, row_compare_scalar},
+#endif // SIMD_X86
+#ifdef SIMD_NEON
+    [PSO_ISA_NEON] = {rng_fill_neon, row_update_neon, rng_fill_float_neon, row_update_float_neon, row_compare_neon},
+#else
+    [PSO_ISA_NEON] = {rng_fill_scalar, row_update_scalar, rng_fill_float_scalar, row_update_float_scalar, row_compare_scalar},
+#endif // SIMD_NEON
+};
+
+/**
+ * Checks if instruction set can be used on this processor
+ * @param isa Instruction set
+ * @return true if it is supported
+ */
+bool pso_isa_supported(TPSOIsa isa){
+    switch(isa){
+    case PSO_ISA_SCALAR:
+        return true;
+#ifdef SIMD_X86
+    case PSO_ISA_SSE2:
+        return __builtin_cpu_supports("sse2");
+    case PSO_ISA_AVX2:
+        return __builtin_cpu_supports("avx2");
+    case PSO_ISA_AVX512:
+        return __builtin_cpu_supports("avx512f");
+#endif // SIMD_X86
+#ifdef SIMD_NEON
+    case PSO_ISA_NEON:
+        return true;
+#endif // SIMD_NEON
+    default:
+        return false;
+    }
+}
+
+/**
+ * Sets instruction set used by vectorized parts of PSO module
+ * @param isa Instruction set, PSO_ISA_AUTO chooses the best supported one
+ * @return true if instruction set is supported and was set
+ */
+bool pso_set_isa(TPSOIsa isa){
+    if(isa == PSO_ISA_AUTO){
+        const TPSOIsa order[] = {PSO_ISA_AVX512, PSO_ISA_AVX2, PSO_ISA_SSE2, PSO_ISA_NEON};
+        isa = PSO_ISA_SCALAR;
+        for(size_t i = 0; i < sizeof(order)/sizeof(order[0]); i++){
+            if(pso_isa_supported(order[i])){
+                isa = order[i];
+                break;
+            }
+        }
+    }
+    else if(!pso_isa_supported(isa)){
+        return false;
+    }
+    atomic_store(&active_isa, (int)isa);
+    return true;
+}
+
+/**
+ * Returns instruction set used by vectorized parts of PSO module
+ * @return Used instruction set
+ */
+TPSOIsa pso_get_isa(){
+    int isa = atomic_load_explicit(&active_isa, memory_order_relaxed);
+    if(isa < 0){
+        pso_set_isa(PSO_ISA_AUTO);
+        isa = atomic_load(&active_isa);
+    }
+    return (TPSOIsa)isa;
+}
+
+/**
+ * Fills array with random doubles in range of <0, 1)
+ * @param lanes Generator lanes
+ * @param out Array to be filled
+ * @param n Amount of doubles to be generated
+ * @note Generated values are the same no matter which implementation is used
+ */
+void rng_lanes_fill(TRngLanes *lanes, double *out, size_t n){
+    size_t steps = n / RNG_LANES;
+    simd_kernels[pso_get_isa()].rng_fill(lanes, out, steps);
+    // Values for the rest of the array are generated into buffer
+    size_t rest = n - steps * RNG_LANES;
+    if(rest > 0){
+        double tail[RNG_LANES];
+        lanes_step_scalar(lanes, tail);
+        memcpy(out + steps * RNG_LANES, tail, rest * sizeof(double));
+    }
+}
+
+/**
+ * Updates velocity and position of row of particles
+ * @param velocity Row of velocities
+ * @param position Row of positions
+ * @param rand_p Cognitive random numbers
+ * @param rand_g Social random numbers
+ * @param personal Row of personal best coordinates (NULL if social attractor is used instead)
+ * @param social Row of social attractors (NULL if all particles use prm->social)
+ * @param rand_r Random numbers for positions of particles which crossed bounds (NULL if they are not reinitialized)
+ * @param n Amount of particles in the row
+ * @param prm Update parameters
+ */
+void row_update(double *velocity, double *position, const double *rand_p, const double *rand_g, const double *personal, const double *social, const double *rand_r, size_t n, const TRowUpdate *prm){
+    simd_kernels[pso_get_isa()].row_update(velocity, position, rand_p, rand_g, personal, social, rand_r, n, prm);
+}
+
+/**
+ * Fills array with random floats in range of <0, 1)
+ * @param lanes Generator lanes
+ * @param out Array to be filled
+ * @param n Amount of floats to be generated
+ * @note Generated values are the same no matter which implementation is used
+ */
+void rng_lanes_fill_float(TRngLanes *lanes, float *out, size_t n){
+    size_t steps = n / RNG_LANES;
+    simd_kernels[pso_get_isa()].rng_fill_float(lanes, out, steps);
+    size_t rest = n - steps * RNG_LANES;
+    if(rest > 0){
+        float tail[RNG_LANES];
+        lanes_step_float_scalar(lanes, tail);
+        memcpy(out + steps * RNG_LANES, tail, rest * sizeof(float));
+    }
+}
+
+/**
+ * Updates velocity and position of row of single precision particles
+ * @param velocity Row of velocities
+ * @param position Row of positions
+ * @param rand_p Cognitive random numbers
+ * @param rand_g Social random numbers
+ * @param personal Row of personal best coordinates (NULL if social attractor is used instead)
+ * @param social Row of social attractors (NULL if all particles use prm->social)
+ * @param rand_r Random numbers for positions of particles which crossed bounds (NULL if they are not reinitialized)
+ * @param n Amount of particles in the row
+ * @param prm Update parameters (rounded to single precision)
+ */
+void row_update_float(float *velocity, float *position, const float *rand_p, const float *rand_g, const float *personal, const float *social, const float *rand_r, size_t n, const TRowUpdate *prm){
+    simd_kernels[pso_get_isa()].row_update_float(velocity, position, rand_p, rand_g, personal, social, rand_r, n, prm);
+}
+
+/**
+ * Compares row of values with one value
+ * @param row Row of values
+ * @param x Compared value
+ * @param n Amount of values in the row
+ * @param flags Bit 0 is set in flags of values lower than x and bit 1 in flags of values greater than x
+ *              (other bits are kept, so that more rows can be compared into the same flags)
+ * @return Bitwise and of all updated flags
+ */
+uint64_t row_compare(const double *row, double x, size_t n, uint64_t *flags){
+    return simd_kernels[pso_get_isa()].row_compare(row, x, n, flags);
+}
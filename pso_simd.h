@@ -0,0 +1,117 @@
+/**
+ * @file pso_simd.h
+ * @author Marek Sedláček
+ * @date October 2026
+ *
+ * @brief Internal header file for vectorized parts of PSO module
+ *
+ * This header file contains declarations of functions used by
+ * the structure of arrays engine in pso.c which process whole
+ * rows of the swarm at once. Their implementations use SIMD
+ * instructions chosen at runtime (see pso_set_isa) and fall
+ * back to plain C loops.
+ *
+ * This header is not part of public PSO interface.
+ */
+
+#ifndef _PSO_SIMD_H_
+#define _PSO_SIMD_H_
+
+#include "pso.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define RNG_LANES 8  //< Amount of independent generators in TRngLanes
+
+/**
+ * Multiple independent xoshiro256** generators stored by state word
+ * Word `w` of lane `l` is `s[w][l]`, so all lanes are advanced by the same
+ * vector instructions without any dependency between them.
+ */
+typedef struct {
+    _Alignas(64) uint64_t s[4][RNG_LANES];  //< States of all lanes
+} TRngLanes;
+
+/**
+ * Seeds all lanes using generator
+ * Each lane gets its seed from the generator and expands it using splitmix64
+ * @param lanes Lanes to seed
+ * @param rng Generator used for seeding
+ */
+void rng_lanes_seed(TRngLanes *lanes, TPSORng *rng);
+
+/**
+ * Fills array with random doubles in range of <0, 1)
+ * @param lanes Generator lanes
+ * @param out Array to be filled
+ * @param n Amount of doubles to be generated
+ * @note Generated values are the same no matter which implementation is used
+ */
+void rng_lanes_fill(TRngLanes *lanes, double *out, size_t n);
+
+/**
+ * Parameters for updating one row (one coordinate of many particles)
+ */
+typedef struct {
+    double w;       //< Inertia coefficient
+    double cp;      //< Cognitive coefficient
+    double cg;      //< Social coefficient
+    double social;  //< Coordinate of global best position (used when there is no row of social attractors)
+    double min;     //< Minimal coordinate allowed by bounds
+    double max;     //< Maximal coordinate allowed by bounds
+    double vmax;    //< Velocity limit (INFINITY if velocity is not limited)
+    bool reflect;   //< If position which crossed bound is mirrored at it (otherwise it is clamped)
+    double bounce;  //< Velocity of particle which crossed bound is multiplied by this
+} TRowUpdate;
+
+/**
+ * Updates velocity and position of row of particles
+ * Velocity is limited and position is kept in bounds (see TRowUpdate) without data dependent branches
+ * @param velocity Row of velocities
+ * @param position Row of positions
+ * @param rand_p Cognitive random numbers
+ * @param rand_g Social random numbers
+ * @param personal Row of personal best coordinates (NULL if social attractor is used instead, as the legacy update does)
+ * @param social Row of social attractors, e.g. neighborhood bests (NULL if all particles use prm->social)
+ * @param rand_r Random numbers for positions of particles which crossed bounds (NULL if they are not reinitialized)
+ * @param n Amount of particles in the row
+ * @param prm Update parameters
+ */
+void row_update(double *velocity, double *position, const double *rand_p, const double *rand_g, const double *personal, const double *social, const double *rand_r, size_t n, const TRowUpdate *prm);
+
+/**
+ * Fills array with random floats in range of <0, 1)
+ * @param lanes Generator lanes
+ * @param out Array to be filled
+ * @param n Amount of floats to be generated
+ * @note Generated values are the same no matter which implementation is used
+ */
+void rng_lanes_fill_float(TRngLanes *lanes, float *out, size_t n);
+
+/**
+ * Updates velocity and position of row of single precision particles
+ * Vectors have twice as many lanes as for doubles, otherwise it is the same as row_update
+ * @param velocity Row of velocities
+ * @param position Row of positions
+ * @param rand_p Cognitive random numbers
+ * @param rand_g Social random numbers
+ * @param personal Row of personal best coordinates (NULL if social attractor is used instead)
+ * @param social Row of social attractors (NULL if all particles use prm->social)
+ * @param rand_r Random numbers for positions of particles which crossed bounds (NULL if they are not reinitialized)
+ * @param n Amount of particles in the row
+ * @param prm Update parameters (rounded to single precision)
+ */
+void row_update_float(float *velocity, float *position, const float *rand_p, const float *rand_g, const float *personal, const float *social, const float *rand_r, size_t n, const TRowUpdate *prm);
+
+/**
+ * Compares row of values with one value
+ * @param row Row of values
+ * @param x Compared value
+ * @param n Amount of values in the row
+ * @param flags Bit 0 is set in flags of values lower than x and bit 1 in flags of values greater than x
+ *              (other bits are kept, so that more rows can be compared into the same flags)
+ * @return Bitwise and of all updated flags
+ */
+uint64_t row_compare(const double *row, double x, size_t n, uint64_t *flags);
+
+#endif //_PSO_SIMD_H_
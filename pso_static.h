@@ -0,0 +1,279 @@
+/**
+ * @file pso_static.h
+ * @author Marek Sedláček
+ * @date October 2026
+ *
+ * @brief Generator of fixed size PSO functions
+ *
+ * This header is a template, it has no include guard and every
+ * inclusion defines one particle swarm optimization function with
+ * the amount of dimensions and particles fixed at compile time.
+ * Such function does not use dynamical allocation and loops over
+ * coordinates are fully unrolled.
+ *
+ * Usage:
+ *
+ *     #define PSO_STATIC_NAME pso5dim_static
+ *     #define PSO_STATIC_DIMENSIONS 5
+ *     #define PSO_STATIC_PARTICLES 32    // optional (PSO3DIM_STATIC_PARTICLES)
+ *     #define PSO_STATIC_LINKAGE static  // optional (external linkage)
+ *     #define PSO_STATIC_STORAGE static  // optional (swarm on the stack)
+ *     #include "pso_static.h"
+ *
+ * which defines function:
+ *
+ *     double pso5dim_static(funcndim function, double bounds[4][2], fit_func fitness,
+ *                           unsigned long max_iter, TPSORng *rng, double best_pos[4]);
+ *
+ * Parameters are the same as for psondim, `rng` is the generator to be used
+ * (if NULL, it is seeded as for calls without explicit seed), the best found
+ * coordinates are written into `best_pos` and the best value is returned
+ * (NAN when `max_iter` is 0).
+ *
+ * When `PSO_STATIC_STORAGE` is `static` the swarm is in static storage and
+ * the function is not reentrant (it must not be called from more threads at once).
+ *
+ * The objective and fitness function can be fixed at compile time too, so that
+ * they are inlined into the loop instead of being called through pointers:
+ *
+ *     static inline double sphere(double x, double y){ return x*x + y*y; }
+ *
+ *     #define PSO_STATIC_NAME pso3dim_sphere
+ *     #define PSO_STATIC_DIMENSIONS 3
+ *     #define PSO_STATIC_OBJECTIVE(pos) sphere((pos)[0], (pos)[1])  // func3dim or funcndim call
+ *     #define PSO_STATIC_FITNESS(a, b) ((a) < (b))                  // optional
+ *     #include "pso_static.h"
+ *
+ * which defines the same function without `function` and `fitness` parameters:
+ *
+ *     double pso3dim_sphere(double bounds[2][2], unsigned long max_iter, TPSORng *rng, double best_pos[2]);
+ *
+ * `PSO_STATIC_OBJECTIVE` gets coordinates of particle (array of `double`) and
+ * `PSO_STATIC_FITNESS` gets two values, they have to be expressions.
+ *
+ * When `PSO_INSTRUMENT` is defined (it has to be defined for pso.c too),
+ * the function updates instrumentation counters and calls iteration callback
+ * (see pso_instrument_stats).
+ *
+ * All configuration macros are undefined at the end of this header.
+ */
+
+#include "pso.h"
+#include <math.h>
+
+#ifndef PSO_STATIC_NAME
+#error "PSO_STATIC_NAME has to be defined before including pso_static.h"
+#endif
+#ifndef PSO_STATIC_DIMENSIONS
+#error "PSO_STATIC_DIMENSIONS has to be defined before including pso_static.h"
+#endif
+#ifndef PSO_STATIC_PARTICLES
+#define PSO_STATIC_PARTICLES PSO3DIM_STATIC_PARTICLES
+#endif
+#ifndef PSO_STATIC_LINKAGE
+#define PSO_STATIC_LINKAGE
+#endif
+#ifndef PSO_STATIC_STORAGE
+#define PSO_STATIC_STORAGE
+#endif
+
+// Objective and fitness are either inlined expressions or parameters of the function
+#ifdef PSO_STATIC_OBJECTIVE
+#define PSO_STATIC_EVALUATE(pos) (PSO_STATIC_OBJECTIVE(pos))
+#define PSO_STATIC_FUNCTION_PARAM
+#else
+#define PSO_STATIC_EVALUATE(pos) function(pos)
+#define PSO_STATIC_FUNCTION_PARAM funcndim function,
+#endif
+#ifdef PSO_STATIC_FITNESS
+#define PSO_STATIC_BETTER(a, b) (PSO_STATIC_FITNESS(a, b))
+#define PSO_STATIC_FITNESS_PARAM
+#else
+#define PSO_STATIC_BETTER(a, b) fitness(a, b)
+#define PSO_STATIC_FITNESS_PARAM fit_func fitness,
+#endif
+
+#ifndef PSO_STATIC_HELPERS
+#define PSO_STATIC_HELPERS  //< Helpers are defined only by the 1st inclusion
+
+/**
+ * Generates random double in range of <min, max)
+ * This is the generator of pso_rng_double (the same values are generated), it is
+ * repeated here, so that it is inlined into the loop
+ */
+static inline double pso_static_rng_double(TPSORng *rng, double min, double max){
+    uint64_t *s = rng->s;
+    const uint64_t x = s[1] * 5;
+    const uint64_t result = ((x << 7) | (x >> 57)) * 9;
+    const uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = (s[3] << 45) | (s[3] >> 19);
+    return min + (result >> 11) * 0x1.0p-53 * (max - min);
+}
+#endif // PSO_STATIC_HELPERS
+
+#ifndef PSO_STATIC_UNROLL
+#if defined(__GNUC__) && !defined(__clang__)
+#define PSO_STATIC_UNROLL _Pragma("GCC unroll 64")  //< Fully unrolls following loop over coordinates
+#elif defined(__clang__)
+#define PSO_STATIC_UNROLL _Pragma("unroll")
+#else
+#define PSO_STATIC_UNROLL
+#endif
+#endif
+
+PSO_STATIC_LINKAGE double PSO_STATIC_NAME(PSO_STATIC_FUNCTION_PARAM double bounds[(PSO_STATIC_DIMENSIONS) - 1][2], PSO_STATIC_FITNESS_PARAM
+                                          unsigned long max_iter, TPSORng *rng, double best_pos[(PSO_STATIC_DIMENSIONS) - 1]){
+    enum {
+        coords = (PSO_STATIC_DIMENSIONS) - 1,
+        particle_am = PSO_STATIC_PARTICLES
+    };
+    _Static_assert((PSO_STATIC_DIMENSIONS) > 1, "PSO_STATIC_DIMENSIONS has to be at least 2");
+    _Static_assert((PSO_STATIC_PARTICLES) > 0, "PSO_STATIC_PARTICLES has to be at least 1");
+
+    TPSORng local_rng;
+    if(!rng){
+        pso_rng_default(&local_rng);
+        rng = &local_rng;
+    }
+
+    // Swarm (every particle has its coordinates next to each other, so they can be passed to the function)
+    PSO_STATIC_STORAGE double velocity[particle_am][coords];
+    PSO_STATIC_STORAGE double position[particle_am][coords];
+    PSO_STATIC_STORAGE double pbest_pos[particle_am][coords];
+    PSO_STATIC_STORAGE double pbest_val[particle_am];
+
+    // Initialize the particles
+    for(unsigned int a = 0; a < particle_am; a++){
+        PSO_STATIC_UNROLL
+        for(unsigned int d = 0; d < coords; d++){
+            velocity[a][d] = pso_static_rng_double(rng, -1, 1);
+            pbest_pos[a][d] = position[a][d] = pso_static_rng_double(rng, bounds[d][0], bounds[d][1]);
+        }
+    }
+
+    if(max_iter == 0){
+        PSO_STATIC_UNROLL
+        for(unsigned int d = 0; d < coords; d++){
+            best_pos[d] = 0.0;
+        }
+        return NAN;
+    }
+
+    // The 1st evaluation sets personal bests without comparing and it is peeled from
+    //   the loop, so that the loop compares every value only with the personal best
+#ifdef PSO_INSTRUMENT
+    uint64_t evaluate_ticks = 0;
+    uint64_t bests_start = pso_instrument_ticks();
+#endif // PSO_INSTRUMENT
+    double best_value = 0.0;
+    for(unsigned int a = 0; a < particle_am; a++){
+#ifdef PSO_INSTRUMENT
+        uint64_t call_start = pso_instrument_ticks();
+#endif // PSO_INSTRUMENT
+        double value = PSO_STATIC_EVALUATE(position[a]);
+#ifdef PSO_INSTRUMENT
+        evaluate_ticks += pso_instrument_ticks() - call_start;
+#endif // PSO_INSTRUMENT
+        pbest_val[a] = value;
+        if(a == 0 || PSO_STATIC_BETTER(value, best_value)){
+            best_value = value;
+            PSO_STATIC_UNROLL
+            for(unsigned int d = 0; d < coords; d++){
+                best_pos[d] = position[a][d];
+            }
+        }
+    }
+#ifdef PSO_INSTRUMENT
+    pso_instrument_phase(PSO_PHASE_EVALUATE, evaluate_ticks);
+    pso_instrument_phase(PSO_PHASE_BESTS, pso_instrument_ticks() - bests_start - evaluate_ticks);
+    pso_instrument_iteration(0, best_value, best_pos);
+#endif // PSO_INSTRUMENT
+
+    // Every iteration moves particles and evaluates them (particles are not moved after the last evaluation)
+    for(unsigned long i = 1; i < max_iter; i++){
+#ifdef PSO_INSTRUMENT
+        uint64_t update_start = pso_instrument_ticks();
+#endif // PSO_INSTRUMENT
+        // Updating the velocity and position of particles
+        for(unsigned int a = 0; a < particle_am; a++){
+            // Canonical update (see PSO_UPDATE_CANONICAL)
+            PSO_STATIC_UNROLL
+            for(unsigned int d = 0; d < coords; d++){
+                // Random coefficients pre-multiplied by cognitive/social coefficient
+                double rp = pso_static_rng_double(rng, 0, 1) * COEFF_CP;
+                double rg = pso_static_rng_double(rng, 0, 1) * COEFF_CG;
+                double cog_diff = pbest_pos[a][d] - position[a][d];
+                double pos_diff = best_pos[d] - position[a][d];
+                velocity[a][d] = COEFF_W * velocity[a][d] + rp * cog_diff + rg * pos_diff;
+                double x = position[a][d] + velocity[a][d];
+                // Branchless clamping into bounds
+                x = x > bounds[d][0] ? x : bounds[d][0];
+                position[a][d] = x < bounds[d][1] ? x : bounds[d][1];
+            }
+        }
+#ifdef PSO_INSTRUMENT
+        pso_instrument_phase(PSO_PHASE_UPDATE, pso_instrument_ticks() - update_start);
+        // Particles on bounds are counted after the update, so that it is measured as it is
+        for(unsigned int d = 0; d < coords; d++){
+            uint64_t hits = 0;
+            for(unsigned int a = 0; a < particle_am; a++){
+                hits += position[a][d] == bounds[d][0] || position[a][d] == bounds[d][1];
+            }
+            pso_instrument_clamp(d, hits);
+        }
+        // Evaluation is measured call by call, the rest of the loop is best update
+        evaluate_ticks = 0;
+        bests_start = pso_instrument_ticks();
+#endif // PSO_INSTRUMENT
+        for(unsigned int a = 0; a < particle_am; a++){
+            // Evaluate current position of the current particle
+#ifdef PSO_INSTRUMENT
+            uint64_t call_start = pso_instrument_ticks();
+#endif // PSO_INSTRUMENT
+            double value = PSO_STATIC_EVALUATE(position[a]);
+#ifdef PSO_INSTRUMENT
+            evaluate_ticks += pso_instrument_ticks() - call_start;
+#endif // PSO_INSTRUMENT
+            // Check if this is new personal best value
+            if(PSO_STATIC_BETTER(value, pbest_val[a])){
+                pbest_val[a] = value;
+                PSO_STATIC_UNROLL
+                for(unsigned int d = 0; d < coords; d++){
+                    pbest_pos[a][d] = position[a][d];
+                }
+                // Global best has same or better value than any personal best
+                if(PSO_STATIC_BETTER(value, best_value)){
+                    best_value = value;
+                    PSO_STATIC_UNROLL
+                    for(unsigned int d = 0; d < coords; d++){
+                        best_pos[d] = position[a][d];
+                    }
+                }
+            }
+        }
+#ifdef PSO_INSTRUMENT
+        pso_instrument_phase(PSO_PHASE_EVALUATE, evaluate_ticks);
+        pso_instrument_phase(PSO_PHASE_BESTS, pso_instrument_ticks() - bests_start - evaluate_ticks);
+        pso_instrument_iteration(i, best_value, best_pos);
+#endif // PSO_INSTRUMENT
+    }
+
+    return best_value;
+}
+
+#undef PSO_STATIC_NAME
+#undef PSO_STATIC_DIMENSIONS
+#undef PSO_STATIC_PARTICLES
+#undef PSO_STATIC_LINKAGE
+#undef PSO_STATIC_STORAGE
+#undef PSO_STATIC_OBJECTIVE
+#undef PSO_STATIC_FITNESS
+#undef PSO_STATIC_EVALUATE
+#undef PSO_STATIC_BETTER
+#undef PSO_STATIC_FUNCTION_PARAM
+#undef PSO_STATIC_FITNESS_PARAM